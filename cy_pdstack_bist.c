@@ -0,0 +1,295 @@
+/***************************************************************************//**
+* \file cy_pdstack_bist.c
+* \version 4.0
+*
+* Source file of the BIST throughput statistics of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "cy_syslib.h"
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_bist.h"
+#include "cy_pdstack_perf.h"
+
+#if (CY_PD_BIST_STATS_ENABLE)
+
+/* MessageID counters are 3 bits wide. */
+#define BIST_MSG_ID_MASK                (0x7u)
+
+/* Extended flag in B15 of the message header. */
+#define BIST_HDR_EXTD_POS               (15u)
+
+typedef struct
+{
+    cy_stc_pdstack_bist_stats_t         stat;
+    uint32_t                            startStamp;
+    uint32_t                            stopStamp;
+    uint8_t                             rxLastId;
+    uint8_t                             txLastId;
+    bool                                rxIdValid;
+    bool                                crcPending;
+} bist_port_t;
+
+static bist_port_t gl_bist[CY_PD_MAX_NO_OF_PORTS];
+
+static bist_port_t *bist_get(const cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    if ((ptrPdStackContext == NULL) || (ptrPdStackContext->port >= CY_PD_MAX_NO_OF_PORTS))
+    {
+        return NULL;
+    }
+
+    return &gl_bist[ptrPdStackContext->port];
+}
+
+static uint8_t bist_tx_id(const cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    return (uint8_t)(ptrPdStackContext->pdStat.ctrs[CY_PD_SOP].trMsgId & BIST_MSG_ID_MASK);
+}
+
+/* Sent messages are counted from the advance of the transmit MessageID, which
+ * moves on every GoodCRC received. Sampled on each event, so that the 3 bit
+ * counter cannot wrap between two samples while messages are exchanged. */
+static void bist_sample_tx(const cy_stc_pdstack_context_t *ptrPdStackContext, bist_port_t *ptrBist)
+{
+    uint8_t id = bist_tx_id(ptrPdStackContext);
+
+    ptrBist->stat.txCount += (uint32_t)(((uint32_t)id - ptrBist->txLastId) & BIST_MSG_ID_MASK);
+    ptrBist->txLastId      = id;
+}
+
+/* Both MessageID counters restart from zero after a reset. */
+static void bist_resync(const cy_stc_pdstack_context_t *ptrPdStackContext, bist_port_t *ptrBist)
+{
+    ptrBist->txLastId   = bist_tx_id(ptrPdStackContext);
+    ptrBist->rxIdValid  = false;
+    ptrBist->crcPending = false;
+}
+
+static void bist_open(const cy_stc_pdstack_context_t *ptrPdStackContext, bist_port_t *ptrBist, uint32_t now)
+{
+    (void)memset(ptrBist, 0, sizeof(bist_port_t));
+    bist_resync(ptrPdStackContext, ptrBist);
+    ptrBist->startStamp  = now;
+    ptrBist->stat.active = true;
+}
+
+static void bist_rx(const cy_stc_pdstack_context_t *ptrPdStackContext, bist_port_t *ptrBist,
+        const cy_stc_pdstack_pd_packet_t *ptrPkt)
+{
+    uint8_t id;
+    uint8_t gap;
+    bool extd;
+
+    if (ptrPkt->sop != CY_PD_SOP)
+    {
+        return;
+    }
+
+    ptrBist->stat.rxCount++;
+    extd = (((ptrPkt->hdr.val >> BIST_HDR_EXTD_POS) & 0x1u) != 0u);
+    id   = (uint8_t)CY_PD_GET_PD_HDR_ID(ptrPkt->hdr.val);
+
+    if ((!extd) && (ptrPkt->len == 0u) && (ptrPkt->msg == (uint8_t)CY_PD_CTRL_MSG_SOFT_RESET))
+    {
+        /* Restarts the sequence at this message. */
+        bist_resync(ptrPdStackContext, ptrBist);
+    }
+    else if (ptrBist->rxIdValid)
+    {
+        if (id == ptrBist->rxLastId)
+        {
+            ptrBist->stat.retryCount++;
+        }
+        else
+        {
+            gap = (uint8_t)(((uint32_t)id - ptrBist->rxLastId - 1u) & BIST_MSG_ID_MASK);
+            ptrBist->stat.lostCount += gap;
+            if ((ptrBist->crcPending) && (gap == 0u))
+            {
+                ptrBist->stat.retryCount++;
+            }
+        }
+    }
+    else
+    {
+        /* First message of the sequence. */
+    }
+
+    ptrBist->rxLastId   = id;
+    ptrBist->rxIdValid  = true;
+    ptrBist->crcPending = false;
+
+    if ((!extd) && (ptrPkt->len != 0u) && (ptrPkt->msg == (uint8_t)CY_PDSTACK_DATA_MSG_BIST))
+    {
+        ptrBist->stat.lastMode = (cy_en_pdstack_bist_mode_t)CY_PD_GET_BIST_MODE(ptrPkt->dat[CY_PD_BDO_HDR_IDX].val);
+        if (ptrBist->stat.lastMode == CY_PDSTACK_BIST_TEST_DATA_MODE)
+        {
+            ptrBist->stat.testDataCount++;
+        }
+        else if ((ptrBist->stat.lastMode >= CY_PDSTACK_BIST_CARRIER_MODE_0) &&
+                (ptrBist->stat.lastMode <= CY_PDSTACK_BIST_CARRIER_MODE_3))
+        {
+            ptrBist->stat.carrierCount++;
+        }
+        else
+        {
+            /* Other BIST modes are only recorded. */
+        }
+    }
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_BistStatStart(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    bist_port_t *ptrBist = bist_get(ptrPdStackContext);
+    uint32_t intrState;
+
+    if (ptrBist == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    bist_open(ptrPdStackContext, ptrBist, CY_PDSTACK_GET_TIME_US());
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_BistStatStartAll(
+        cy_stc_pdstack_context_t * const ptrPdStackContext[],
+        uint8_t numPorts)
+{
+    uint32_t intrState;
+    uint32_t now;
+    uint8_t i;
+
+    if ((ptrPdStackContext == NULL) || (numPorts == 0u))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    for (i = 0u; i < numPorts; i++)
+    {
+        if (bist_get(ptrPdStackContext[i]) == NULL)
+        {
+            return CY_PDSTACK_STAT_BAD_PARAM;
+        }
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    now = CY_PDSTACK_GET_TIME_US();
+    for (i = 0u; i < numPorts; i++)
+    {
+        bist_open(ptrPdStackContext[i], bist_get(ptrPdStackContext[i]), now);
+    }
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_BistStatStop(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    bist_port_t *ptrBist = bist_get(ptrPdStackContext);
+    uint32_t intrState;
+
+    if (ptrBist == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    if (ptrBist->stat.active)
+    {
+        bist_sample_tx(ptrPdStackContext, ptrBist);
+        ptrBist->stopStamp   = CY_PDSTACK_GET_TIME_US();
+        ptrBist->stat.active = false;
+    }
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+void Cy_PdStack_Dpm_BistEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data)
+{
+    bist_port_t *ptrBist = bist_get(ptrPdStackContext);
+
+    if ((ptrBist == NULL) || (!ptrBist->stat.active))
+    {
+        return;
+    }
+
+    bist_sample_tx(ptrPdStackContext, ptrBist);
+
+    switch (evt)
+    {
+        case APP_EVT_PKT_RCVD:
+            if (data != NULL)
+            {
+                bist_rx(ptrPdStackContext, ptrBist, (const cy_stc_pdstack_pd_packet_t *)data);
+            }
+            break;
+
+        case APP_EVT_CRC_ERROR:
+            ptrBist->stat.crcErrCount++;
+            ptrBist->crcPending = true;
+            break;
+
+        case APP_EVT_HARD_RESET_RCVD:
+        case APP_EVT_HARD_RESET_SENT:
+        case APP_EVT_SOFT_RESET_SENT:
+        case APP_EVT_DISCONNECT:
+        case APP_EVT_TYPE_C_ERROR_RECOVERY:
+            bist_resync(ptrPdStackContext, ptrBist);
+            break;
+
+        default:
+            /* Not counted. */
+            break;
+    }
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_BistGetStats(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_bist_stats_t *ptrStats)
+{
+    bist_port_t *ptrBist = bist_get(ptrPdStackContext);
+    uint32_t intrState;
+
+    if ((ptrBist == NULL) || (ptrStats == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    if (ptrBist->stat.active)
+    {
+        bist_sample_tx(ptrPdStackContext, ptrBist);
+        ptrBist->stat.elapsedUs = CY_PDSTACK_GET_TIME_US() - ptrBist->startStamp;
+    }
+    else
+    {
+        ptrBist->stat.elapsedUs = ptrBist->stopStamp - ptrBist->startStamp;
+    }
+    *ptrStats = ptrBist->stat;
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+#endif /* (CY_PD_BIST_STATS_ENABLE) */
+
+/* [] END OF FILE */
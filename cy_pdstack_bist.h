@@ -0,0 +1,169 @@
+/***************************************************************************//**
+* \file cy_pdstack_bist.h
+* \version 4.0
+*
+* Header file of the BIST throughput statistics of the PDStack middleware.
+* Measurement windows are opened on one or all ports at once, and the
+* messages received and sent, the BIST test data and carrier requests, the
+* CRC failures, retried and lost messages of each port are counted during the
+* window, so that a production tester can derive PHY error rates while
+* running BIST on several ports in parallel.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_BIST_H)
+#define CY_PDSTACK_BIST_H
+
+#include "cy_pdstack_common.h"
+
+/**
+* \addtogroup group_pdstack_data_structures
+* \{
+*/
+
+/**
+ * @brief BIST statistics of a port, counted on SOP while the measurement
+ * window is open. Times are in us and stay zero unless CY_PD_PERF_GET_TIME_US
+ * is provided.
+ */
+typedef struct
+{
+    bool                        active;         /**< Measurement window is open. */
+    cy_en_pdstack_bist_mode_t   lastMode;       /**< Mode of the last BIST message received. */
+    uint32_t                    rxCount;        /**< Messages received, BIST test data included. */
+    uint32_t                    txCount;        /**< Messages sent and acknowledged with GoodCRC. */
+    uint32_t                    testDataCount;  /**< BIST messages with a test data BDO received. */
+    uint32_t                    carrierCount;   /**< BIST carrier mode requests received. */
+    uint32_t                    crcErrCount;    /**< Messages received with a CRC failure. */
+    uint32_t                    retryCount;     /**< Retries of the partner: CRC failures followed by the expected
+                                                     MessageID, and repeated MessageIDs. */
+    uint32_t                    lostCount;      /**< Messages missed, from gaps in the MessageID sequence. */
+    uint32_t                    elapsedUs;      /**< Length of the window, up to now while it is open. */
+} cy_stc_pdstack_bist_stats_t;
+
+/** \} group_pdstack_data_structures */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_BistStatStart
+****************************************************************************//**
+*
+* Clears the BIST statistics of a port and opens its measurement window.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_BistStatStart(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_BistStatStartAll
+****************************************************************************//**
+*
+* Opens the measurement windows of several ports in one critical section, so
+* that all windows share the same start time when BIST runs on the ports in
+* parallel. The counters of each port are kept separately and never shared.
+*
+* \param ptrPdStackContext
+* Array of PDStack library context pointers.
+*
+* \param numPorts
+* Number of entries in the ptrPdStackContext array.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid. No window
+* is opened in this case.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_BistStatStartAll(
+        cy_stc_pdstack_context_t * const ptrPdStackContext[],
+        uint8_t numPorts);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_BistStatStop
+****************************************************************************//**
+*
+* Closes the measurement window of a port. The statistics are kept until the
+* next start.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_BistStatStop(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_BistEventHandler
+****************************************************************************//**
+*
+* Counts APP_EVT_PKT_RCVD and APP_EVT_CRC_ERROR on a port with an open
+* window. CRC failures are only reported when CY_PD_CRC_ERR_HANDLING_ENABLE is
+* set. The MessageID counters of the port restart on resets, which is taken
+* into account. To be called from the application event handler.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param evt
+* Event ID.
+*
+* \param data
+* Event data.
+*
+* \return
+* None
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_BistEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_BistGetStats
+****************************************************************************//**
+*
+* Reports the BIST statistics of a port. Can be called while the window is
+* open.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrStats
+* Output parameter which receives the statistics.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_BistGetStats(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_bist_stats_t *ptrStats);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_BIST_H */
+
+/* [] END OF FILE */
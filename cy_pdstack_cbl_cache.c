@@ -0,0 +1,256 @@
+/***************************************************************************//**
+* \file cy_pdstack_cbl_cache.c
+* \version 4.0
+*
+* Source file of the cable discovery cache of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include "cy_syslib.h"
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_dpm.h"
+#include "cy_pdstack_cbl_cache.h"
+
+#if (CY_PD_CBL_CACHE_ENABLE)
+
+/* Fields of the passive cable VDO and active cable VDO 1. */
+#define CBL_VDO_VBUS_CUR_POS            (5u)
+#define CBL_VDO_VBUS_CUR_MASK           (0x3u)
+#define CBL_VDO_MAX_VBUS_POS            (9u)
+#define CBL_VDO_MAX_VBUS_MASK           (0x3u)
+#define CBL_VDO_EPR_CAP_POS             (17u)
+
+/* FNV-1a parameters. */
+#define CBL_FNV_OFFSET                  (0x811C9DC5u)
+#define CBL_FNV_PRIME                   (0x01000193u)
+
+typedef struct
+{
+    cy_stc_pdstack_cbl_cache_entry_t    entry;
+    cy_en_pdstack_cbl_cache_state_t     state;
+} cbl_cache_t;
+
+static cbl_cache_t gl_cblCache[CY_PD_MAX_NO_OF_PORTS];
+
+static cbl_cache_t *cbl_cache_get(const cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    if ((ptrPdStackContext == NULL) || (ptrPdStackContext->port >= CY_PD_MAX_NO_OF_PORTS))
+    {
+        return NULL;
+    }
+
+    return &gl_cblCache[ptrPdStackContext->port];
+}
+
+static uint32_t cbl_fnv_word(uint32_t hash, uint32_t val)
+{
+    uint8_t i;
+
+    for (i = 0u; i < 4u; i++)
+    {
+        hash ^= (val & 0xFFu);
+        hash *= CBL_FNV_PRIME;
+        val >>= 8u;
+    }
+
+    return hash;
+}
+
+static uint32_t cbl_fingerprint(const cy_stc_pdstack_cbl_cache_entry_t *ptrEntry)
+{
+    uint32_t hash = CBL_FNV_OFFSET;
+
+    hash = cbl_fnv_word(hash, ((uint32_t)ptrEntry->cblType << 8u) | (uint32_t)ptrEntry->cblVdmVersion);
+    hash = cbl_fnv_word(hash, ptrEntry->cblVdo.val);
+    hash = cbl_fnv_word(hash, ptrEntry->cblVdo2.val);
+
+    return hash;
+}
+
+static void cbl_cache_cap(const cbl_cache_t *ptrCache, cy_stc_pdstack_cbl_cache_cap_t *ptrCap)
+{
+    uint32_t vdo = ptrCache->entry.cblVdo.val;
+
+    ptrCap->state = ptrCache->state;
+
+    /* The cached result is decoded as soon as a cable marker is present, so
+     * that the application can prepare the matching capabilities. */
+    if (ptrCache->state == CY_PDSTACK_CBL_CACHE_NONE)
+    {
+        ptrCap->provVbusCur    = CY_PDSTACK_CBL_VBUS_CUR_3A;
+        ptrCap->provEprCapable = false;
+        ptrCap->provUsbSig     = CY_PDSTACK_USB_SIG_UNKNOWN;
+    }
+    else
+    {
+        ptrCap->provVbusCur    = (cy_en_pdstack_cbl_vbus_cur_t)((vdo >> CBL_VDO_VBUS_CUR_POS) & CBL_VDO_VBUS_CUR_MASK);
+        ptrCap->provEprCapable = ((((vdo >> CBL_VDO_EPR_CAP_POS) & 0x1u) != 0u) &&
+                (((vdo >> CBL_VDO_MAX_VBUS_POS) & CBL_VDO_MAX_VBUS_MASK) == CY_PD_MAX_CBL_VBUS_50V));
+        ptrCap->provUsbSig     = (cy_en_pdstack_usb_data_sig_t)ptrCache->entry.usbSig;
+    }
+
+    /* Only a confirmed result is used: more than 3 A and EPR need the
+     * confirmation of the cable marker of this connection. */
+    if (ptrCache->state != CY_PDSTACK_CBL_CACHE_CONFIRMED)
+    {
+        ptrCap->vbusCur    = CY_PDSTACK_CBL_VBUS_CUR_3A;
+        ptrCap->eprCapable = false;
+        ptrCap->usbSig     = CY_PDSTACK_USB_SIG_UNKNOWN;
+    }
+    else
+    {
+        ptrCap->vbusCur    = ptrCap->provVbusCur;
+        ptrCap->eprCapable = ptrCap->provEprCapable;
+        ptrCap->usbSig     = ptrCap->provUsbSig;
+    }
+}
+
+/* Only a confirmation, its withdrawal or a real change of the confirmed
+ * capabilities is a difference; the provisional fields are not compared. */
+static bool cbl_cap_differs(const cy_stc_pdstack_cbl_cache_cap_t *ptrA, const cy_stc_pdstack_cbl_cache_cap_t *ptrB)
+{
+    return ((ptrA->vbusCur != ptrB->vbusCur) || (ptrA->eprCapable != ptrB->eprCapable) ||
+            (ptrA->usbSig != ptrB->usbSig) ||
+            ((ptrA->state == CY_PDSTACK_CBL_CACHE_CONFIRMED) != (ptrB->state == CY_PDSTACK_CBL_CACHE_CONFIRMED)));
+}
+
+bool Cy_PdStack_Dpm_CblCacheEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data)
+{
+    cbl_cache_t *ptrCache = cbl_cache_get(ptrPdStackContext);
+    cy_stc_pdstack_cbl_cache_cap_t before;
+    cy_stc_pdstack_cbl_cache_cap_t after;
+    cy_stc_pdstack_cbl_cache_entry_t found;
+
+    CY_UNUSED_PARAMETER(data);
+
+    if (ptrCache == NULL)
+    {
+        return false;
+    }
+
+    cbl_cache_cap(ptrCache, &before);
+
+    switch (evt)
+    {
+        case APP_EVT_TYPEC_ATTACH:
+            ptrCache->state = ((ptrCache->entry.valid != 0u) && (ptrPdStackContext->dpmStat.raPresent)) ?
+                CY_PDSTACK_CBL_CACHE_PROVISIONAL : CY_PDSTACK_CBL_CACHE_NONE;
+            break;
+
+        case APP_EVT_EMCA_DETECTED:
+            found.cblVdo        = ptrPdStackContext->dpmStat.cblVdo;
+            found.cblVdo2.val   = (ptrPdStackContext->dpmStat.cblType == CY_PDSTACK_PROD_TYPE_ACT_CBL) ?
+                ptrPdStackContext->dpmStat.cblVdo2.val : 0u;
+            found.cblType       = (uint8_t)ptrPdStackContext->dpmStat.cblType;
+            found.cblVdmVersion = (uint8_t)ptrPdStackContext->dpmStat.cblVdmVersion;
+            found.fingerprint   = cbl_fingerprint(&found);
+
+            if ((ptrCache->entry.valid == 0u) || (ptrCache->entry.fingerprint != found.fingerprint))
+            {
+                found.usbSig   = (uint8_t)Cy_PdStack_Dpm_GetCableUsbCap(ptrPdStackContext);
+                found.valid    = 1u;
+                ptrCache->entry = found;
+            }
+            ptrCache->state = CY_PDSTACK_CBL_CACHE_CONFIRMED;
+            break;
+
+        case APP_EVT_EMCA_NOT_DETECTED:
+            if (ptrCache->state == CY_PDSTACK_CBL_CACHE_PROVISIONAL)
+            {
+                ptrCache->entry.valid = 0u;
+                ptrCache->state       = CY_PDSTACK_CBL_CACHE_NONE;
+            }
+            break;
+
+        case APP_EVT_DISCONNECT:
+        case APP_EVT_TYPE_C_ERROR_RECOVERY:
+            ptrCache->state = CY_PDSTACK_CBL_CACHE_NONE;
+            return false;
+
+        default:
+            /* Not related to cable discovery. */
+            break;
+    }
+
+    cbl_cache_cap(ptrCache, &after);
+    return cbl_cap_differs(&before, &after);
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_CblCacheGetCap(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_cbl_cache_cap_t *ptrCap)
+{
+    cbl_cache_t *ptrCache = cbl_cache_get(ptrPdStackContext);
+
+    if ((ptrCache == NULL) || (ptrCap == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    cbl_cache_cap(ptrCache, ptrCap);
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_CblCacheGetEntry(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_cbl_cache_entry_t *ptrEntry)
+{
+    cbl_cache_t *ptrCache = cbl_cache_get(ptrPdStackContext);
+
+    if ((ptrCache == NULL) || (ptrEntry == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    *ptrEntry = ptrCache->entry;
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_CblCacheSetEntry(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        const cy_stc_pdstack_cbl_cache_entry_t *ptrEntry)
+{
+    cbl_cache_t *ptrCache = cbl_cache_get(ptrPdStackContext);
+
+    if ((ptrCache == NULL) || (ptrEntry == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    ptrCache->entry = *ptrEntry;
+    ptrCache->entry.fingerprint = cbl_fingerprint(ptrEntry);
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_CblCacheInvalidate(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    cbl_cache_t *ptrCache = cbl_cache_get(ptrPdStackContext);
+
+    if (ptrCache == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    ptrCache->entry.valid = 0u;
+    if (ptrCache->state == CY_PDSTACK_CBL_CACHE_PROVISIONAL)
+    {
+        ptrCache->state = CY_PDSTACK_CBL_CACHE_NONE;
+    }
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+#endif /* (CY_PD_CBL_CACHE_ENABLE) */
+
+/* [] END OF FILE */
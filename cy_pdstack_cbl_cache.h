@@ -0,0 +1,223 @@
+/***************************************************************************//**
+* \file cy_pdstack_cbl_cache.h
+* \version 4.0
+*
+* Header file of the cable discovery cache of the PDStack middleware. The
+* result of the last cable (EMCA) discovery of each port is kept across
+* detach, so that the cable capabilities can be used as soon as a cable
+* marker is seen again and are only confirmed by the discovery run as part of
+* the attach.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_CBL_CACHE_H)
+#define CY_PDSTACK_CBL_CACHE_H
+
+#include "cy_pdstack_common.h"
+
+/**
+* \addtogroup group_pdstack_enums
+* \{
+*/
+
+/**
+ * @typedef cy_en_pdstack_cbl_cache_state_t
+ * @brief State of the cable information of a port.
+ */
+typedef enum
+{
+    CY_PDSTACK_CBL_CACHE_NONE = 0,      /**< No cable information for the current connection. */
+    CY_PDSTACK_CBL_CACHE_PROVISIONAL,   /**< A cable marker is present and a cached result is held;
+                                             discovery has not confirmed it yet. */
+    CY_PDSTACK_CBL_CACHE_CONFIRMED      /**< Reported result is from the discovery of the current
+                                             connection. */
+} cy_en_pdstack_cbl_cache_state_t;
+
+/** \} group_pdstack_enums */
+
+/**
+* \addtogroup group_pdstack_data_structures
+* \{
+*/
+
+/**
+ * @brief Cached cable discovery result. Can be saved by the application, for
+ * example to flash, and restored with Cy_PdStack_Dpm_CblCacheSetEntry.
+ */
+typedef struct
+{
+    uint32_t        fingerprint;        /**< Hash of the cable identity, see Cy_PdStack_Dpm_CblCacheEventHandler. */
+    cy_pd_pd_do_t   cblVdo;             /**< Cable VDO (passive) or active cable VDO 1. */
+    cy_pd_pd_do_t   cblVdo2;            /**< Active cable VDO 2, zero for passive cables. */
+    uint8_t         cblType;            /**< Cable type, cy_en_pdstack_std_vdm_prod_t. */
+    uint8_t         cblVdmVersion;      /**< Structured VDM version of the cable, cy_en_pdstack_std_vdm_ver_t. */
+    uint8_t         usbSig;             /**< USB signaling, cy_en_pdstack_usb_data_sig_t. */
+    uint8_t         valid;              /**< Non-zero if the entry holds a result. */
+} cy_stc_pdstack_cbl_cache_entry_t;
+
+/**
+ * @brief Cable capabilities reported for the current connection.
+ */
+typedef struct
+{
+    cy_en_pdstack_cbl_cache_state_t state;      /**< Origin of the information below. */
+    cy_en_pdstack_cbl_vbus_cur_t    vbusCur;    /**< VBus current capability. CY_PDSTACK_CBL_VBUS_CUR_3A
+                                                     unless the state is CY_PDSTACK_CBL_CACHE_CONFIRMED. */
+    bool                            eprCapable; /**< Cable is EPR mode capable and rated for 50 V. false
+                                                     unless the state is CY_PDSTACK_CBL_CACHE_CONFIRMED. */
+    cy_en_pdstack_usb_data_sig_t    usbSig;     /**< USB signaling supported by the cable.
+                                                     CY_PDSTACK_USB_SIG_UNKNOWN unless the state is
+                                                     CY_PDSTACK_CBL_CACHE_CONFIRMED. */
+    cy_en_pdstack_cbl_vbus_cur_t    provVbusCur;    /**< Provisional: VBus current capability of the
+                                                         cached cable, in both the provisional and the
+                                                         confirmed state. Not to be advertised before
+                                                         the confirmation. */
+    bool                            provEprCapable; /**< Provisional: EPR capability of the cached
+                                                         cable, as for provVbusCur. */
+    cy_en_pdstack_usb_data_sig_t    provUsbSig;     /**< Provisional: USB signaling of the cached
+                                                         cable, as for provVbusCur. */
+} cy_stc_pdstack_cbl_cache_cap_t;
+
+/** \} group_pdstack_data_structures */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_CblCacheEventHandler
+****************************************************************************//**
+*
+* Maintains the cache from the application events of the port. To be called
+* from the application event handler.
+*
+* - APP_EVT_TYPEC_ATTACH with a cable marker (Ra) present and a valid entry
+*   moves to CY_PDSTACK_CBL_CACHE_PROVISIONAL. The cached capabilities are
+*   reported in the provisional fields only until the result is confirmed.
+* - APP_EVT_EMCA_DETECTED compares the fingerprint (cable type, VDM version
+*   and cable VDOs) of the discovery result with the entry, replaces the entry
+*   on mismatch and makes the result CY_PDSTACK_CBL_CACHE_CONFIRMED.
+*   Repeated discoveries of the same cable, for example after a data role or
+*   VConn swap, leave the reported capabilities unchanged.
+* - APP_EVT_EMCA_NOT_DETECTED invalidates a provisional result.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param evt
+* Event ID.
+*
+* \param data
+* Event data.
+*
+* \return
+* true if the capabilities reported by Cy_PdStack_Dpm_CblCacheGetCap have
+* changed, or the result has been confirmed or withdrawn, in which case the
+* application re-evaluates the source capabilities it advertises. Moving to
+* CY_PDSTACK_CBL_CACHE_PROVISIONAL is not reported.
+*
+*******************************************************************************/
+bool Cy_PdStack_Dpm_CblCacheEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_CblCacheGetCap
+****************************************************************************//**
+*
+* Reports the cable capabilities for the current connection.
+*
+* Only a confirmed result is reported in vbusCur, eprCapable and usbSig;
+* otherwise they are the 3 A defaults. The prov* fields carry the decoded
+* cached result from CY_PDSTACK_CBL_CACHE_PROVISIONAL on, so that the
+* application can precompute the PDOs of the cached cable and send them from
+* the event in which Cy_PdStack_Dpm_CblCacheEventHandler reports the
+* confirmation.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrCap
+* Output parameter which receives the capabilities.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_CblCacheGetCap(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_cbl_cache_cap_t *ptrCap);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_CblCacheGetEntry
+****************************************************************************//**
+*
+* Copies the cache entry of the port.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrEntry
+* Output parameter which receives the entry.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_CblCacheGetEntry(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_cbl_cache_entry_t *ptrEntry);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_CblCacheSetEntry
+****************************************************************************//**
+*
+* Restores a previously saved cache entry. Takes effect from the next attach.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrEntry
+* Entry to be restored. The fingerprint is recalculated.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_CblCacheSetEntry(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        const cy_stc_pdstack_cbl_cache_entry_t *ptrEntry);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_CblCacheInvalidate
+****************************************************************************//**
+*
+* Discards the cache entry of the port. A provisional result is withdrawn.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_CblCacheInvalidate(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_CBL_CACHE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,177 @@
+/***************************************************************************//**
+* \file cy_pdstack_cfg_valid.c
+* \version 4.0
+*
+* Source file of the port configuration validation support of the PDStack
+* middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_dpm.h"
+#include "cy_pdstack_cfg_valid.h"
+
+#if ((CY_PD_PORT_CFG_CRC_ENABLE) && (!CY_USE_CONFIG_TABLE))
+
+/* Bytes of mfgLenInfo taken by the VID and PID. */
+#define CFG_MFG_ID_LEN                  (4u)
+
+/* Configurations which have passed validation. */
+typedef struct
+{
+    const cy_stc_pdstack_port_cfg_t *ptrPortCfg;
+    uint32_t                         crc;
+} cfg_valid_entry_t;
+
+static cfg_valid_entry_t gl_cfgValid[CY_PD_MAX_NO_OF_PORTS];
+
+/* CRC-32 (reflected 0x04C11DB7), processed one nibble at a time. */
+static const uint32_t gl_crcNibble[16] =
+{
+    0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu,
+    0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+    0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+    0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu
+};
+
+static uint32_t cfg_crc_update(uint32_t crc, const uint8_t *ptrData, uint32_t len)
+{
+    uint32_t i;
+
+    for (i = 0u; i < len; i++)
+    {
+        crc ^= ptrData[i];
+        crc = (crc >> 4u) ^ gl_crcNibble[crc & 0x0Fu];
+        crc = (crc >> 4u) ^ gl_crcNibble[crc & 0x0Fu];
+    }
+
+    return crc;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_PortCfg_CalcCrc(
+        const cy_stc_pdstack_port_cfg_t *ptrPortCfg,
+        uint32_t *ptrCrc)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+
+    if ((ptrPortCfg == NULL) || (ptrCrc == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    crc = cfg_crc_update(crc, (const uint8_t *)ptrPortCfg, (uint32_t)sizeof(cy_stc_pdstack_port_cfg_t));
+
+    if ((ptrPortCfg->mfgName != NULL) && (ptrPortCfg->mfgLenInfo > CFG_MFG_ID_LEN))
+    {
+        crc = cfg_crc_update(crc, ptrPortCfg->mfgName, (uint32_t)ptrPortCfg->mfgLenInfo - CFG_MFG_ID_LEN);
+    }
+    if (ptrPortCfg->extSrcCap != NULL)
+    {
+        crc = cfg_crc_update(crc, ptrPortCfg->extSrcCap, ptrPortCfg->extSrcCapSize);
+    }
+    if (ptrPortCfg->extSnkCap != NULL)
+    {
+        crc = cfg_crc_update(crc, ptrPortCfg->extSnkCap, ptrPortCfg->extSnkCapSize);
+    }
+
+    *ptrCrc = ~crc;
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_PortCfg_Validate(
+        const cy_stc_pdstack_port_cfg_t *ptrPortCfg,
+        uint32_t expCrc)
+{
+    uint32_t crc = 0u;
+
+    if (ptrPortCfg == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    if (ptrPortCfg->signature != CY_PDSTACK_PORT_CFG_SIGNATURE)
+    {
+        return CY_PDSTACK_STAT_INVALID_SIGNATURE;
+    }
+
+    if ((ptrPortCfg->portRole > (uint8_t)CY_PD_PRT_DUAL) ||
+            (ptrPortCfg->srcPdoCount > CY_PD_MAX_NO_OF_PDO) ||
+            (ptrPortCfg->snkPdoCount > CY_PD_MAX_NO_OF_PDO) ||
+            (ptrPortCfg->eprSrcPdoCount > CY_PD_MAX_NO_OF_EPR_PDO) ||
+            (ptrPortCfg->eprSnkPdoCount > CY_PD_MAX_NO_OF_EPR_PDO))
+    {
+        return CY_PDSTACK_STAT_INVALID_ARGUMENT;
+    }
+
+    (void)Cy_PdStack_PortCfg_CalcCrc(ptrPortCfg, &crc);
+    if (crc != expCrc)
+    {
+        return CY_PDSTACK_STAT_FAILURE;
+    }
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_InitValidated(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_usbpd_context_t *ptrUsbPdContext,
+        const cy_stc_pdstack_port_cfg_t *ptrPortCfg,
+        uint32_t expCrc,
+        cy_stc_pdstack_app_cbk_t *ptrAppCbk,
+        const cy_stc_pdstack_dpm_params_t *ptrDpmParams,
+        cy_stc_pdutils_sw_timer_t *ptrTimerContext)
+{
+    cy_en_pdstack_status_t stat;
+    bool known = false;
+    uint8_t freeIdx = CY_PD_MAX_NO_OF_PORTS;
+    uint8_t i;
+
+    if (ptrPortCfg == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    for (i = 0u; i < CY_PD_MAX_NO_OF_PORTS; i++)
+    {
+        if ((gl_cfgValid[i].ptrPortCfg == ptrPortCfg) && (gl_cfgValid[i].crc == expCrc))
+        {
+            known = true;
+            break;
+        }
+        if ((gl_cfgValid[i].ptrPortCfg == NULL) && (freeIdx == CY_PD_MAX_NO_OF_PORTS))
+        {
+            freeIdx = i;
+        }
+    }
+
+    if (!known)
+    {
+        stat = Cy_PdStack_PortCfg_Validate(ptrPortCfg, expCrc);
+        if (stat != CY_PDSTACK_STAT_SUCCESS)
+        {
+            return stat;
+        }
+
+        /* With more configurations than ports, the extra ones are simply
+         * validated on every call. */
+        if (freeIdx < CY_PD_MAX_NO_OF_PORTS)
+        {
+            gl_cfgValid[freeIdx].ptrPortCfg = ptrPortCfg;
+            gl_cfgValid[freeIdx].crc        = expCrc;
+        }
+    }
+
+    return Cy_PdStack_Dpm_Init(ptrPdStackContext, ptrUsbPdContext, ptrPortCfg, ptrAppCbk,
+            ptrDpmParams, ptrTimerContext);
+}
+
+#endif /* ((CY_PD_PORT_CFG_CRC_ENABLE) && (!CY_USE_CONFIG_TABLE)) */
+
+/* [] END OF FILE */
@@ -0,0 +1,148 @@
+/***************************************************************************//**
+* \file cy_pdstack_cfg_valid.h
+* \version 4.0
+*
+* Header file of the port configuration validation support of the PDStack
+* middleware. A flash-resident port configuration is checked once with a
+* CRC and then used in place.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_CFG_VALID_H)
+#define CY_PDSTACK_CFG_VALID_H
+
+#include "cy_pdstack_common.h"
+
+/**
+* \addtogroup group_pdstack_macros
+* \{
+*/
+
+/** Value of the signature member of cy_stc_pdstack_port_cfg_t ('PDSC'). */
+#define CY_PDSTACK_PORT_CFG_SIGNATURE           (0x50445343u)
+
+/** \} group_pdstack_macros */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_PortCfg_CalcCrc
+****************************************************************************//**
+*
+* Calculates the CRC-32 (IEEE 802.3) of a port configuration. The CRC covers
+* the structure as laid out in memory followed by the manufacturer name and
+* the extended source and sink capability arrays it refers to, so it is
+* specific to the linked image. It is intended to be calculated once, for
+* example on a production or development build, and stored with the image.
+*
+* \param ptrPortCfg
+* Port configuration pointer.
+*
+* \param ptrCrc
+* Output parameter which receives the CRC.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the parameters are invalid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_PortCfg_CalcCrc(
+        const cy_stc_pdstack_port_cfg_t *ptrPortCfg,
+        uint32_t *ptrCrc);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_PortCfg_Validate
+****************************************************************************//**
+*
+* Validates a port configuration: signature, PDO counts, port role and CRC.
+*
+* \param ptrPortCfg
+* Port configuration pointer.
+*
+* \param expCrc
+* Expected CRC, as reported by Cy_PdStack_PortCfg_CalcCrc.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the configuration is valid.
+* CY_PDSTACK_STAT_INVALID_SIGNATURE if the signature does not match.
+* CY_PDSTACK_STAT_INVALID_ARGUMENT if a count or role is out of range.
+* CY_PDSTACK_STAT_FAILURE if the CRC does not match.
+* CY_PDSTACK_STAT_BAD_PARAM if the parameters are invalid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_PortCfg_Validate(
+        const cy_stc_pdstack_port_cfg_t *ptrPortCfg,
+        uint32_t expCrc);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_InitValidated
+****************************************************************************//**
+*
+* Validates the port configuration and initializes the port through
+* Cy_PdStack_Dpm_Init, which keeps a const pointer to the configuration, so
+* that the configuration is used in place from flash. Validation is only done
+* for the first initialization of a port with a given configuration and CRC;
+* later calls, for example after the port has been stopped, skip directly to
+* Cy_PdStack_Dpm_Init.
+*
+* The record of validated configurations is kept in RAM and cleared at reset,
+* so every cold boot runs the full validation once per port before
+* Cy_PdStack_Dpm_Init: a CRC over the whole cy_stc_pdstack_port_cfg_t
+* structure, the manufacturer name and the extended capabilities, with two
+* table lookups per byte. An application whose image is already verified at
+* boot, for example by its bootloader, can call Cy_PdStack_Dpm_Init directly
+* to avoid this delay.
+*
+* Runtime changes through Cy_PdStack_Dpm_UpdatePortConfig and the
+* Cy_PdStack_Dpm_Update* capability functions are applied to the RAM state of
+* the context and leave the configuration itself untouched.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrUsbPdContext
+* USB PD driver context pointer.
+*
+* \param ptrPortCfg
+* Port configuration pointer.
+*
+* \param expCrc
+* Expected CRC, as reported by Cy_PdStack_PortCfg_CalcCrc.
+*
+* \param ptrAppCbk
+* Application callback function pointer.
+*
+* \param ptrDpmParams
+* Pointer to the DPM parameter information structure.
+*
+* \param ptrTimerContext
+* Pointer to soft timer context structure.
+*
+* \return
+* Status of Cy_PdStack_PortCfg_Validate if the validation fails, otherwise the
+* status of Cy_PdStack_Dpm_Init.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_InitValidated(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_usbpd_context_t *ptrUsbPdContext,
+        const cy_stc_pdstack_port_cfg_t *ptrPortCfg,
+        uint32_t expCrc,
+        cy_stc_pdstack_app_cbk_t *ptrAppCbk,
+        const cy_stc_pdstack_dpm_params_t *ptrDpmParams,
+        cy_stc_pdutils_sw_timer_t *ptrTimerContext);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_CFG_VALID_H */
+
+/* [] END OF FILE */
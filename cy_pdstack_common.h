@@ -188,6 +188,14 @@
 * \section section_pdstack_miscellaneous Limitations and restrictions
 ********************************************************************************
 * Version 4.0 of the PDStack middleware is compatible with EZ-PD&trade; Configurator 2.0.
+*
+* The layout of cy_stc_pdstack_context_t is shared by all library variants and
+* is fixed by the pre-compiled libraries; the per-port state cannot be trimmed
+* or shared across ports without rebuilding the libraries. Use
+* Cy_PdStack_Mem_GetFootprint to obtain the per-port RAM usage of the build and
+* define CY_PD_CONTEXT_SIZE_BUDGET to fail the build when the context exceeds
+* a given size. For the same reason, the AMS scratch buffers of the policy
+* engine cannot be shared across ports through a pool.
 ********************************************************************************
 * \section section_pdstack_toolchain Supported software and tools
 ********************************************************************************
@@ -229,7 +237,7 @@
 * <table class="doxtable">
 *   <tr><th>Version</th><th>Changes</th><th>Reason for change</th></tr>
 *   <tr>
-*     <td> 4.0</td>
+*     <td rowspan="30">4.0</td>
 *     <td>Updated to USB PD Revision 3.2 Version 1.0
 * \note
 *      This version of the PDStack middleware is compatible with EZ-PD&trade;
@@ -238,6 +246,220 @@
 *     <td>Feature addition</td>
 *   </tr>
 *   <tr>
+*     <td>Added event-driven task scheduling support (cy_pdstack_sched.h).
+*     Cy_PdStack_Dpm_TaskPending runs the stack task only when work is
+*     pending on the port and Cy_PdStack_Dpm_GetNextWakeup reports the next
+*     stack deadline. Enabled using CY_PD_EVENT_DRIVEN_TASK_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added Cy_PdStack_Dpm_RtosTaskLoop, an RTOS task entry point which
+*     blocks in dpm_rtos_evt_take until the next stack deadline or posted event.
+*     A task can serve a single port or all ports.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added a lock-free single-producer/single-consumer ring of received PD
+*     messages (cy_pdstack_rx_ring.h) with high-watermark and overflow counters.
+*     Enabled using CY_PD_RX_RING_ENABLE; depth set by CY_PD_RX_RING_DEPTH.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added a bounded, priority-ordered DPM PD command queue per port
+*     (cy_pdstack_dpm_queue.h) with per-command completion callbacks and
+*     cancellation. Enabled using CY_PD_DPM_CMD_QUEUE_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added extended message views (cy_pdstack_extd_msg.h). Single chunk
+*     messages are delivered in place and chunked messages are reassembled
+*     directly into application-registered buffers. Enabled using
+*     CY_PD_EXTD_MSG_VIEW_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added Cy_PdStack_Mem_GetFootprint to report the per-port context RAM
+*     usage and CY_PD_CONTEXT_SIZE_BUDGET to enforce a context size budget at
+*     build time.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added the Cy_PdStack_TimerWheel_* hierarchical timer wheel with
+*     constant time start, stop and next deadline query, enabled through
+*     CY_PD_TIMER_WHEEL_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added Cy_PdStack_Dpm_GetSleepBudget to report the deep sleep
+*     duration allowed by the soft timer deadlines of all ports.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added optional latency instrumentation with per-port min, max and
+*     histogram statistics read through Cy_PdStack_Dpm_GetPerfStats,
+*     enabled through CY_PD_PERF_STATS_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added the Cy_PdStack_Dpm_SnkSel* sink contract selection engine
+*     which scores all PDO types against a precomputed sink capability table,
+*     enabled through CY_PD_SNK_SEL_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added cached source RDO validation (Cy_PdStack_Dpm_SrcRdoValidate)
+*     which checks requests against a decoded view of the advertised source
+*     capabilities, enabled through CY_PD_SRC_RDO_CACHE_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added the Cy_PdStack_Dpm_PpsStream* streaming request mode which turns
+*     latest-value-wins PPS/AVS setpoints into requests paced by contract
+*     completion, enabled through CY_PD_PPS_STREAM_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added the compile-time port configuration (cy_pdstack_static_cfg.h).
+*     CY_PD_STATIC_CFG_* settings fix the port role, EPR, PPS and FRS use at
+*     build time and remove unused roles and features from the source modules,
+*     enabled through CY_PD_STATIC_CFG_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added Cy_PdStack_Dpm_InitValidated, which validates a flash-resident
+*     port configuration once with a CRC (Cy_PdStack_PortCfg_Validate) and
+*     uses it in place, enabled through CY_PD_PORT_CFG_CRC_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added the binary event trace (cy_pdstack_trace.h), a per-port ring of
+*     eight byte records of Type-C and PE state changes, application events,
+*     received messages and DPM commands, read with Cy_PdStack_Dpm_GetTrace and
+*     decoded with tools/pdstack_trace_decode.py. Enabled using CY_PD_TRACE_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added the contract negotiation, EPR entry and cable discovery statistics
+*     recorded by Cy_PdStack_Perf_Event, and the host-side report and regression
+*     gate tools/pdstack_perf_gate.py.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added Cy_PdStack_Dpm_TaskAll, which runs all ports with pending work in one
+*     pass, most urgent first. Cy_PdStack_Dpm_RtosTaskRun now uses it.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added the Fast Role Swap fast path (cy_pdstack_frs.h): pre-approved swaps,
+*     an interrupt-level power path action, a ready-made eval_fr_swap callback and
+*     measured swap timing. Enabled using CY_PD_FRS_FAST_PATH_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added the cable discovery cache (cy_pdstack_cbl_cache.h), which keeps the
+*     last EMCA result per port across reconnects and reports provisional and
+*     confirmed cable capabilities. Enabled using CY_PD_CBL_CACHE_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added the embedded controller status snapshot (cy_pdstack_ec_snap.h): one
+*     versioned structure for all ports with a sequence number and per-port change
+*     masks. Enabled using CY_PD_EC_SNAPSHOT_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added coalesced application event delivery (cy_pdstack_evt_coalesce.h):
+*     non-critical events are batched per port and delivered once per task pass or
+*     after a quiet time, power safety events stay synchronous. Enabled using
+*     CY_PD_EVT_COALESCE_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added the pipelined SOP discovery engine (cy_pdstack_vdm_disc.h): Discover
+*     Identity, SVIDs and Modes are chained from the response callbacks and reported
+*     as one discovery table, which is kept across soft resets. Enabled using
+*     CY_PD_VDM_DISC_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added the fast re-contract path (cy_pdstack_recontract.h): renegotiations after
+*     soft reset, PD revision downgrade or power role swap which find the same offer
+*     are answered from the previous contract. Enabled using
+*     CY_PD_FAST_RECONTRACT_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added the EPR keepalive offload (cy_pdstack_epr_ka.h): an EPR sink keepalive
+*     is sent ahead of other deferred work when the one of the stack is overdue,
+*     with drift and miss statistics. Enabled using CY_PD_EPR_KA_OFFLOAD_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added the BIST throughput statistics (cy_pdstack_bist.h): per-port counters of
+*     messages sent and received, BIST test data and carrier requests, CRC failures,
+*     retries and lost messages over measurement windows opened on one or all ports.
+*     Enabled using CY_PD_BIST_STATS_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added the protocol layer statistics (cy_pdstack_prl_stats.h): saturating
+*     per-SOP counters of messages sent, GoodCRC failures, discards, receptions and
+*     CRC failures, with hard resets by reason and a snapshot/clear API. Enabled
+*     using CY_PD_PRL_STATS_ENABLE.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added Cy_PdStack_Dpm_SetSchedHook: the optional modules install their deferred
+*     work on first use, so that the linker drops the modules an application does
+*     not call. Added tools/pdstack_footprint.py for per-object flash/RAM reports.
+*     </td>
+*     <td>Enhancement</td>
+*   </tr>
+*   <tr>
+*     <td>Added the fast VBus fault response (CY_PD_FAST_FAULT_ENABLE):
+*     Cy_PdStack_Dpm_FaultIsr gates the power path from the fault interrupt, and the
+*     Alert, hard reset or error recovery is handed to the stack ahead of the next
+*     stack task, with reaction time statistics. Added the CY_PDSTACK_PEND_FAULT
+*     pending-work flag and the CY_PDSTACK_SCHED_HOOK_FAULT slot, served before all
+*     other work.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
+*     <td>Added the power telemetry ring (CY_PD_TELEMETRY_ENABLE): per-port ring of
+*     time-stamped VBus and contract samples, taken at a rate set through
+*     Cy_PdStack_Dpm_TelemetryStart, and of contract change records, drained in bulk
+*     through Cy_PdStack_Dpm_TelemetryDrain.
+*     </td>
+*     <td>Feature addition</td>
+*   </tr>
+*   <tr>
 *     <td> 3.20.1</td>
 *     <td> Corrected page header of API reference manual
 *     </td>
@@ -401,6 +623,8 @@
 
 #endif /* CCGx */
 
+#include "cy_pdstack_static_cfg.h"
+
 #endif /* CY_PDSTACK_COMMON_H */
 
 /* [] END OF FILE */
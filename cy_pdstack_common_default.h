@@ -81,6 +81,166 @@
 #define CY_PD_VDM_DISABLE                (0u)
 #endif /* CY_PD_VDM_DISABLE */
 
+#ifndef CY_PD_MAX_NO_OF_PORTS
+#define CY_PD_MAX_NO_OF_PORTS            (2u)
+#endif /* CY_PD_MAX_NO_OF_PORTS */
+
+#ifndef CY_PD_EVENT_DRIVEN_TASK_ENABLE
+#define CY_PD_EVENT_DRIVEN_TASK_ENABLE   (0u)
+#endif /* CY_PD_EVENT_DRIVEN_TASK_ENABLE */
+
+#ifndef CY_PD_RX_RING_ENABLE
+#define CY_PD_RX_RING_ENABLE             (0u)
+#endif /* CY_PD_RX_RING_ENABLE */
+
+/* Number of messages held by the receive message ring. Must be a power of two
+ * and not larger than 128. */
+#ifndef CY_PD_RX_RING_DEPTH
+#define CY_PD_RX_RING_DEPTH              (4u)
+#endif /* CY_PD_RX_RING_DEPTH */
+
+#ifndef CY_PD_DPM_CMD_QUEUE_ENABLE
+#define CY_PD_DPM_CMD_QUEUE_ENABLE       (0u)
+#endif /* CY_PD_DPM_CMD_QUEUE_ENABLE */
+
+/* Number of DPM PD commands that can be queued per port. */
+#ifndef CY_PD_DPM_CMD_QUEUE_DEPTH
+#define CY_PD_DPM_CMD_QUEUE_DEPTH        (4u)
+#endif /* CY_PD_DPM_CMD_QUEUE_DEPTH */
+
+#ifndef CY_PD_EXTD_MSG_VIEW_ENABLE
+#define CY_PD_EXTD_MSG_VIEW_ENABLE       (0u)
+#endif /* CY_PD_EXTD_MSG_VIEW_ENABLE */
+
+/* Number of application-owned extended message receive buffers per port. */
+#ifndef CY_PD_EXTD_RX_BUF_COUNT
+#define CY_PD_EXTD_RX_BUF_COUNT          (2u)
+#endif /* CY_PD_EXTD_RX_BUF_COUNT */
+
+/* Upper limit in bytes for sizeof(cy_stc_pdstack_context_t). The build fails
+ * if the context exceeds it. Zero disables the check. */
+#ifndef CY_PD_CONTEXT_SIZE_BUDGET
+#define CY_PD_CONTEXT_SIZE_BUDGET        (0u)
+#endif /* CY_PD_CONTEXT_SIZE_BUDGET */
+
+#ifndef CY_PD_TIMER_WHEEL_ENABLE
+#define CY_PD_TIMER_WHEEL_ENABLE         (0u)
+#endif /* CY_PD_TIMER_WHEEL_ENABLE */
+
+#ifndef CY_PD_PERF_STATS_ENABLE
+#define CY_PD_PERF_STATS_ENABLE          (0u)
+#endif /* CY_PD_PERF_STATS_ENABLE */
+
+/* Upper limit in us of the first latency histogram bin; each further bin doubles it. */
+#ifndef CY_PD_PERF_HIST_BASE_US
+#define CY_PD_PERF_HIST_BASE_US          (256u)
+#endif /* CY_PD_PERF_HIST_BASE_US */
+
+#ifndef CY_PD_SNK_SEL_ENABLE
+#define CY_PD_SNK_SEL_ENABLE             (0u)
+#endif /* CY_PD_SNK_SEL_ENABLE */
+
+#ifndef CY_PD_SRC_RDO_CACHE_ENABLE
+#define CY_PD_SRC_RDO_CACHE_ENABLE       (0u)
+#endif /* CY_PD_SRC_RDO_CACHE_ENABLE */
+
+#ifndef CY_PD_PPS_STREAM_ENABLE
+#define CY_PD_PPS_STREAM_ENABLE          (0u)
+#endif /* CY_PD_PPS_STREAM_ENABLE */
+
+/* Fixes the port role and optional features at build time. See
+ * cy_pdstack_static_cfg.h for the associated CY_PD_STATIC_CFG_* settings. */
+#ifndef CY_PD_STATIC_CFG_ENABLE
+#define CY_PD_STATIC_CFG_ENABLE          (0u)
+#endif /* CY_PD_STATIC_CFG_ENABLE */
+
+#ifndef CY_PD_PORT_CFG_CRC_ENABLE
+#define CY_PD_PORT_CFG_CRC_ENABLE        (0u)
+#endif /* CY_PD_PORT_CFG_CRC_ENABLE */
+
+#ifndef CY_PD_TRACE_ENABLE
+#define CY_PD_TRACE_ENABLE               (0u)
+#endif /* CY_PD_TRACE_ENABLE */
+
+/* Number of binary trace records kept per port. Must be a power of two and
+ * not larger than 256. */
+#ifndef CY_PD_TRACE_DEPTH
+#define CY_PD_TRACE_DEPTH                (32u)
+#endif /* CY_PD_TRACE_DEPTH */
+
+#ifndef CY_PD_FRS_FAST_PATH_ENABLE
+#define CY_PD_FRS_FAST_PATH_ENABLE       (0u)
+#endif /* CY_PD_FRS_FAST_PATH_ENABLE */
+
+#ifndef CY_PD_CBL_CACHE_ENABLE
+#define CY_PD_CBL_CACHE_ENABLE           (0u)
+#endif /* CY_PD_CBL_CACHE_ENABLE */
+
+#ifndef CY_PD_EC_SNAPSHOT_ENABLE
+#define CY_PD_EC_SNAPSHOT_ENABLE         (0u)
+#endif /* CY_PD_EC_SNAPSHOT_ENABLE */
+
+/* Change in mV of the VBus voltage which is reported in the EC snapshot change mask. */
+#ifndef CY_PD_EC_SNAPSHOT_VBUS_DELTA_MV
+#define CY_PD_EC_SNAPSHOT_VBUS_DELTA_MV  (250u)
+#endif /* CY_PD_EC_SNAPSHOT_VBUS_DELTA_MV */
+
+#ifndef CY_PD_EVT_COALESCE_ENABLE
+#define CY_PD_EVT_COALESCE_ENABLE        (0u)
+#endif /* CY_PD_EVT_COALESCE_ENABLE */
+
+#ifndef CY_PD_VDM_DISC_ENABLE
+#define CY_PD_VDM_DISC_ENABLE            (0u)
+#endif /* CY_PD_VDM_DISC_ENABLE */
+
+/* Number of SVIDs held in the discovery table of each port. */
+#ifndef CY_PD_VDM_DISC_MAX_SVIDS
+#define CY_PD_VDM_DISC_MAX_SVIDS         (8u)
+#endif /* CY_PD_VDM_DISC_MAX_SVIDS */
+
+#ifndef CY_PD_FAST_RECONTRACT_ENABLE
+#define CY_PD_FAST_RECONTRACT_ENABLE     (0u)
+#endif /* CY_PD_FAST_RECONTRACT_ENABLE */
+
+#ifndef CY_PD_EPR_KA_OFFLOAD_ENABLE
+#define CY_PD_EPR_KA_OFFLOAD_ENABLE      (0u)
+#endif /* CY_PD_EPR_KA_OFFLOAD_ENABLE */
+
+/* Time in ms without an EPR_KeepAlive_Ack after which the EPR keepalive
+ * offload sends a keepalive. Longer than the stack period, so that only an
+ * overdue keepalive of the stack is replaced, and within the 500 ms
+ * tSinkEPRKeepAlive limit. */
+#ifndef CY_PD_EPR_KA_PERIOD
+#define CY_PD_EPR_KA_PERIOD              (CY_PD_EPR_SNK_KEEPALIVE_TIMER_PERIOD + 50u)
+#endif /* CY_PD_EPR_KA_PERIOD */
+
+#ifndef CY_PD_BIST_STATS_ENABLE
+#define CY_PD_BIST_STATS_ENABLE          (0u)
+#endif /* CY_PD_BIST_STATS_ENABLE */
+
+#ifndef CY_PD_PRL_STATS_ENABLE
+#define CY_PD_PRL_STATS_ENABLE           (0u)
+#endif /* CY_PD_PRL_STATS_ENABLE */
+
+#ifndef CY_PD_FAST_FAULT_ENABLE
+#define CY_PD_FAST_FAULT_ENABLE          (0u)
+#endif /* CY_PD_FAST_FAULT_ENABLE */
+
+/* Send an Alert with the fault type ahead of the hard reset of the fast fault
+ * response, on PD 3.x contracts. */
+#ifndef CY_PD_FAST_FAULT_ALERT_ENABLE
+#define CY_PD_FAST_FAULT_ALERT_ENABLE    (0u)
+#endif /* CY_PD_FAST_FAULT_ALERT_ENABLE */
+
+#ifndef CY_PD_TELEMETRY_ENABLE
+#define CY_PD_TELEMETRY_ENABLE           (0u)
+#endif /* CY_PD_TELEMETRY_ENABLE */
+
+/* Number of records in the telemetry ring of each port, a power of two. */
+#ifndef CY_PD_TELEMETRY_DEPTH
+#define CY_PD_TELEMETRY_DEPTH            (32u)
+#endif /* CY_PD_TELEMETRY_DEPTH */
+
 /**
 * \addtogroup group_pdstack_macros
 * \{
@@ -0,0 +1,472 @@
+/***************************************************************************//**
+* \file cy_pdstack_dpm_queue.c
+* \version 4.0
+*
+* Source file of the queued DPM command interface of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include "cy_syslib.h"
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_dpm.h"
+#include "cy_pdstack_dpm_queue.h"
+#include "cy_pdstack_perf.h"
+#if (CY_PD_TRACE_ENABLE)
+#include "cy_pdstack_trace.h"
+#endif /* (CY_PD_TRACE_ENABLE) */
+#if (CY_PD_EVENT_DRIVEN_TASK_ENABLE)
+#include "cy_pdstack_sched.h"
+#endif /* (CY_PD_EVENT_DRIVEN_TASK_ENABLE) */
+
+#if (CY_PD_DPM_CMD_QUEUE_ENABLE)
+
+/* A free tag must always exist for the queued and the active commands. */
+#if (CY_PD_DPM_CMD_QUEUE_DEPTH > 254u)
+#error "CY_PD_DPM_CMD_QUEUE_DEPTH must not exceed 254."
+#endif
+
+/* Queued command. */
+typedef struct
+{
+    cy_stc_pdstack_dpm_pd_cmd_buf_t buf;
+    cy_pdstack_dpm_pd_cmd_cbk_t     cbk;
+    cy_en_pdstack_dpm_pd_cmd_t      cmd;
+    uint8_t                         prio;
+    uint8_t                         tag;
+    bool                            hasBuf;
+} dpm_queue_entry_t;
+
+/* Per-port queue. Entries are kept sorted, index 0 is started next. */
+typedef struct
+{
+    dpm_queue_entry_t               entry[CY_PD_DPM_CMD_QUEUE_DEPTH];
+    uint8_t                         count;
+    uint8_t                         nextTag;
+
+    /* The buffer handed to the stack must stay untouched while its AMS runs,
+     * so a new command is always staged in the other buffer. */
+    cy_stc_pdstack_dpm_pd_cmd_buf_t activeBuf[2];
+    uint8_t                         activeSlot;
+
+    /* Command currently owned by the stack. */
+    cy_pdstack_dpm_pd_cmd_cbk_t     activeCbk;
+    uint8_t                         activeTag;
+    bool                            active;
+    bool                            activeRespExp;
+
+#if (CY_PD_PERF_STATS_ENABLE)
+    /* Time at which the active command was handed to the stack. */
+    uint32_t                        activeStamp;
+#endif /* (CY_PD_PERF_STATS_ENABLE) */
+} dpm_queue_t;
+
+static dpm_queue_t gl_dpmQueue[CY_PD_MAX_NO_OF_PORTS];
+
+static dpm_queue_t *dpm_queue_get(const cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    if ((ptrPdStackContext == NULL) || (ptrPdStackContext->port >= CY_PD_MAX_NO_OF_PORTS))
+    {
+        return NULL;
+    }
+
+    return &gl_dpmQueue[ptrPdStackContext->port];
+}
+
+static void dpm_queue_kick(cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+#if (CY_PD_EVENT_DRIVEN_TASK_ENABLE)
+    (void)Cy_PdStack_Dpm_SetSchedHook(CY_PDSTACK_SCHED_HOOK_CMD_QUEUE, Cy_PdStack_Dpm_CmdQueueTask);
+    (void)Cy_PdStack_Dpm_SetPendingWork(ptrPdStackContext, CY_PDSTACK_PEND_DPM_CMD);
+#else
+    CY_UNUSED_PARAMETER(ptrPdStackContext);
+#endif /* (CY_PD_EVENT_DRIVEN_TASK_ENABLE) */
+}
+
+static void dpm_queue_remove(dpm_queue_t *q, uint8_t idx)
+{
+    uint8_t i;
+
+    if (idx >= q->count)
+    {
+        return;
+    }
+
+    for (i = idx; (i + 1u) < q->count; i++)
+    {
+        q->entry[i] = q->entry[i + 1u];
+    }
+    q->count--;
+}
+
+/* Returns the next tag which is neither queued nor held by the stack, so that
+ * a wrapped tag cannot cancel or describe another command. */
+static uint8_t dpm_queue_new_tag(dpm_queue_t *q)
+{
+    uint8_t tag;
+    uint8_t i;
+    bool used;
+
+    do
+    {
+        tag  = q->nextTag++;
+        used = (q->active) && (q->activeTag == tag);
+        for (i = 0u; (i < q->count) && (!used); i++)
+        {
+            used = (q->entry[i].tag == tag);
+        }
+    } while (used);
+
+    return tag;
+}
+
+/* Whether the stack waits for a response to the command after it has been
+ * sent. For the others, CY_PDSTACK_CMD_SENT is the final status. */
+static bool dpm_queue_resp_expected(cy_en_pdstack_dpm_pd_cmd_t cmd,
+        const cy_stc_pdstack_dpm_pd_cmd_buf_t *ptrCmdBuf)
+{
+    switch (cmd)
+    {
+        case CY_PDSTACK_DPM_CMD_SRC_CAP_CHNG:
+        case CY_PDSTACK_DPM_CMD_SNK_CAP_CHNG:
+        case CY_PDSTACK_DPM_CMD_SEND_GO_TO_MIN:
+        case CY_PDSTACK_DPM_CMD_SEND_HARD_RESET:
+        case CY_PDSTACK_DPM_CMD_SEND_SOFT_RESET:
+        case CY_PDSTACK_DPM_CMD_SEND_CABLE_RESET:
+        case CY_PDSTACK_DPM_CMD_SEND_SOFT_RESET_EMCA:
+        case CY_PDSTACK_DPM_CMD_SEND_EXTENDED:
+        case CY_PDSTACK_DPM_CMD_SEND_BATT_STATUS:
+        case CY_PDSTACK_DPM_CMD_SEND_ALERT:
+        case CY_PDSTACK_DPM_CMD_SEND_NOT_SUPPORTED:
+            return false;
+
+        case CY_PDSTACK_DPM_CMD_SEND_VDM:
+            /* The stack only waits for a VDM response with a timeout set. */
+            return ((ptrCmdBuf != NULL) && (ptrCmdBuf->timeout != 0u));
+
+        default:
+            return true;
+    }
+}
+
+/* Completion callback registered with the stack for every queued command. */
+static void dpm_queue_cbk(cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_resp_status_t resp, const cy_stc_pdstack_pd_packet_t *pkt_ptr)
+{
+    dpm_queue_t *q = dpm_queue_get(ptrPdStackContext);
+    cy_pdstack_dpm_pd_cmd_cbk_t cbk;
+
+    /* A late completion of a command released by a flush is dropped. */
+    if ((q == NULL) || (!q->active))
+    {
+        return;
+    }
+
+    cbk = q->activeCbk;
+
+#if (CY_PD_PERF_STATS_ENABLE)
+    if (resp == CY_PDSTACK_CMD_SENT)
+    {
+        CY_PDSTACK_PERF_END(ptrPdStackContext, CY_PDSTACK_PERF_CMD_TO_SENT, q->activeStamp);
+    }
+    else if (resp == CY_PDSTACK_RES_RCVD)
+    {
+        CY_PDSTACK_PERF_END(ptrPdStackContext, CY_PDSTACK_PERF_CMD_TO_RESP, q->activeStamp);
+    }
+    else
+    {
+        /* No latency sample for failed sequences. */
+    }
+#endif /* (CY_PD_PERF_STATS_ENABLE) */
+
+#if (CY_PD_TRACE_ENABLE)
+    Cy_PdStack_Dpm_TraceWrite(ptrPdStackContext, CY_PDSTACK_TRACE_DPM_CMD,
+            (uint8_t)ptrPdStackContext->dpmStat.dpmPdCmd, (uint16_t)resp);
+#endif /* (CY_PD_TRACE_ENABLE) */
+
+    /* CY_PDSTACK_CMD_SENT is followed by the response on commands which
+     * expect one, so keep routing to the same callback until a final status
+     * is seen. */
+    if ((resp != CY_PDSTACK_CMD_SENT) || (!q->activeRespExp))
+    {
+        q->active    = false;
+        q->activeCbk = NULL;
+        if (q->count != 0u)
+        {
+            dpm_queue_kick(ptrPdStackContext);
+        }
+    }
+
+    if (cbk != NULL)
+    {
+        cbk(ptrPdStackContext, resp, pkt_ptr);
+    }
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_QueuePdCommand(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_dpm_pd_cmd_t cmd,
+        const cy_stc_pdstack_dpm_pd_cmd_buf_t *ptrCmdBuf,
+        cy_pdstack_dpm_pd_cmd_cbk_t cmdCbk,
+        uint8_t priority,
+        uint8_t *ptrTag)
+{
+    dpm_queue_t *q = dpm_queue_get(ptrPdStackContext);
+    dpm_queue_entry_t *e;
+    uint8_t tag;
+    uint8_t pos;
+    uint8_t i;
+
+    if ((q == NULL) || (cmd == CY_PDSTACK_DPM_CMD_SEND_INVALID) ||
+            (priority > CY_PDSTACK_CMD_PRIO_HIGH))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    if (q->count >= CY_PD_DPM_CMD_QUEUE_DEPTH)
+    {
+        return CY_PDSTACK_STAT_BUSY;
+    }
+
+    tag = dpm_queue_new_tag(q);
+
+    /* Insert behind all entries of the same or higher priority. */
+    pos = q->count;
+    while ((pos > 0u) && (q->entry[pos - 1u].prio < priority))
+    {
+        pos--;
+    }
+    for (i = q->count; i > pos; i--)
+    {
+        q->entry[i] = q->entry[i - 1u];
+    }
+
+    e         = &q->entry[pos];
+    e->cmd    = cmd;
+    e->cbk    = cmdCbk;
+    e->prio   = priority;
+    e->tag    = tag;
+    e->hasBuf = (ptrCmdBuf != NULL);
+    if (ptrCmdBuf != NULL)
+    {
+        e->buf = *ptrCmdBuf;
+    }
+    q->count++;
+
+    if (ptrTag != NULL)
+    {
+        *ptrTag = e->tag;
+    }
+
+    dpm_queue_kick(ptrPdStackContext);
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_CancelPdCommand(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        uint8_t tag)
+{
+    dpm_queue_t *q = dpm_queue_get(ptrPdStackContext);
+    cy_pdstack_dpm_pd_cmd_cbk_t cbk;
+    uint8_t i;
+
+    if (q == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    for (i = 0u; i < q->count; i++)
+    {
+        if (q->entry[i].tag == tag)
+        {
+            cbk = q->entry[i].cbk;
+            dpm_queue_remove(q, i);
+            if (cbk != NULL)
+            {
+                cbk(ptrPdStackContext, CY_PDSTACK_SEQ_ABORTED, NULL);
+            }
+            return CY_PDSTACK_STAT_SUCCESS;
+        }
+    }
+
+    /* Not queued any more: either owned by the stack or unknown. */
+    return ((q->active) && (q->activeTag == tag)) ? CY_PDSTACK_STAT_BUSY : CY_PDSTACK_STAT_INVALID_ARGUMENT;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_FlushPdCommands(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    dpm_queue_t *q = dpm_queue_get(ptrPdStackContext);
+    cy_pdstack_dpm_pd_cmd_cbk_t cbk[CY_PD_DPM_CMD_QUEUE_DEPTH];
+    cy_pdstack_dpm_pd_cmd_cbk_t activeCbk = NULL;
+    uint8_t count;
+    uint8_t i;
+
+    if (q == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    /* Release the command owned by the stack, so that its late completion
+     * is not routed and the next command is not held back. */
+    if (q->active)
+    {
+        activeCbk    = q->activeCbk;
+        q->active    = false;
+        q->activeCbk = NULL;
+    }
+
+    /* Empty the queue before notifying, the callbacks may queue new commands. */
+    count = q->count;
+    for (i = 0u; i < count; i++)
+    {
+        cbk[i] = q->entry[i].cbk;
+    }
+    q->count = 0u;
+
+    if (activeCbk != NULL)
+    {
+        activeCbk(ptrPdStackContext, CY_PDSTACK_SEQ_ABORTED, NULL);
+    }
+
+    for (i = 0u; i < count; i++)
+    {
+        if (cbk[i] != NULL)
+        {
+            cbk[i](ptrPdStackContext, CY_PDSTACK_SEQ_ABORTED, NULL);
+        }
+    }
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_CmdQueueTask(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    dpm_queue_t *q = dpm_queue_get(ptrPdStackContext);
+    dpm_queue_entry_t e;
+    cy_stc_pdstack_dpm_pd_cmd_buf_t *ptrBuf = NULL;
+    cy_en_pdstack_status_t stat;
+    uint8_t slot;
+    uint8_t i;
+    bool retry = false;
+
+    if (q == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    /* The next command is started from the completion of the active one. */
+    if (q->active)
+    {
+        return CY_PDSTACK_STAT_SUCCESS;
+    }
+
+    /* A rejected command is failed and the next one is tried right away. */
+    while ((q->count != 0u) && (!retry))
+    {
+        /* Taken off the queue and marked active before it is handed over:
+         * the stack may report completion from within the call, and the
+         * callback may queue or flush commands. */
+        e      = q->entry[0];
+        slot   = q->activeSlot ^ 1u;
+        ptrBuf = NULL;
+        if (e.hasBuf)
+        {
+            q->activeBuf[slot] = e.buf;
+            ptrBuf = &q->activeBuf[slot];
+        }
+        dpm_queue_remove(q, 0u);
+
+        q->active        = true;
+        q->activeCbk     = e.cbk;
+        q->activeTag     = e.tag;
+        q->activeRespExp = dpm_queue_resp_expected(e.cmd, ptrBuf);
+
+        CY_PDSTACK_PERF_START(q->activeStamp);
+        stat = Cy_PdStack_Dpm_SendPdCommand(ptrPdStackContext, e.cmd, ptrBuf, false, dpm_queue_cbk);
+        if (stat == CY_PDSTACK_STAT_SUCCESS)
+        {
+            q->activeSlot = slot;
+            break;
+        }
+
+        q->active    = false;
+        q->activeCbk = NULL;
+
+        switch (stat)
+        {
+            case CY_PDSTACK_STAT_BUSY:
+            case CY_PDSTACK_STAT_CMD_FAILURE:
+            case CY_PDSTACK_STAT_NOT_READY:
+                /* Stack cannot take a command now; put back at the head and
+                 * retried on the next pass. */
+                if (q->count < CY_PD_DPM_CMD_QUEUE_DEPTH)
+                {
+                    for (i = q->count; i > 0u; i--)
+                    {
+                        q->entry[i] = q->entry[i - 1u];
+                    }
+                    q->entry[0] = e;
+                    q->count++;
+                    retry = true;
+                    break;
+                }
+
+                /* No room left to put it back; the command is failed. */
+                if (e.cbk != NULL)
+                {
+                    e.cbk(ptrPdStackContext, CY_PDSTACK_CMD_FAILED, NULL);
+                }
+                break;
+
+            default:
+                /* The command itself has been rejected. */
+                if (e.cbk != NULL)
+                {
+                    e.cbk(ptrPdStackContext, CY_PDSTACK_CMD_FAILED, NULL);
+                }
+                break;
+        }
+    }
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+uint8_t Cy_PdStack_Dpm_CmdQueueGetCount(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    dpm_queue_t *q = dpm_queue_get(ptrPdStackContext);
+
+    return (q != NULL) ? q->count : 0u;
+}
+
+void Cy_PdStack_Dpm_CmdQueueEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt)
+{
+    switch (evt)
+    {
+        case APP_EVT_DISCONNECT:
+        case APP_EVT_TYPE_C_ERROR_RECOVERY:
+        case APP_EVT_HARD_RESET_RCVD:
+        case APP_EVT_HARD_RESET_SENT:
+        case APP_EVT_PE_DISABLED:
+            (void)Cy_PdStack_Dpm_FlushPdCommands(ptrPdStackContext);
+            break;
+
+        default:
+            /* No handling required. */
+            break;
+    }
+}
+
+#endif /* (CY_PD_DPM_CMD_QUEUE_ENABLE) */
+
+/* [] END OF FILE */
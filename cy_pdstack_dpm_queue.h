@@ -0,0 +1,200 @@
+/***************************************************************************//**
+* \file cy_pdstack_dpm_queue.h
+* \version 4.0
+*
+* Header file of the queued DPM command interface of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_DPM_QUEUE_H)
+#define CY_PDSTACK_DPM_QUEUE_H
+
+#include "cy_pdstack_common.h"
+
+/*******************************************************************************
+*                              Type definitions
+*******************************************************************************/
+
+/**
+* \addtogroup group_pdstack_macros
+* \{
+*/
+
+/** Lowest queued DPM command priority. */
+#define CY_PDSTACK_CMD_PRIO_LOW                 (0u)
+
+/** Default queued DPM command priority. */
+#define CY_PDSTACK_CMD_PRIO_NORMAL              (1u)
+
+/** Highest queued DPM command priority. */
+#define CY_PDSTACK_CMD_PRIO_HIGH                (2u)
+
+/** \} group_pdstack_macros */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_QueuePdCommand
+****************************************************************************//**
+*
+* Adds a PD command to the per-port command queue. Queued commands are started
+* in priority order (FIFO among equal priorities) by
+* Cy_PdStack_Dpm_CmdQueueTask as soon as the stack accepts a new command, and
+* each command reports its completion through its own callback. The next
+* command is started once the final status of the previous one has been
+* reported: CY_PDSTACK_CMD_SENT for commands which get no response, such as
+* GotoMin, the resets and VDMs without a response timeout, and the response
+* or failure status for all others.
+*
+* The command buffer is copied into the queue. For extended messages, the
+* memory referenced by datPtr must remain valid until the callback reports
+* completion.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param cmd
+* Type of command to be initiated.
+*
+* \param ptrCmdBuf
+* Pointer to the command buffer. Can be NULL for commands without data.
+*
+* \param cmdCbk
+* Pointer to the callback function. Can be NULL.
+*
+* \param priority
+* Command priority, CY_PDSTACK_CMD_PRIO_LOW to CY_PDSTACK_CMD_PRIO_HIGH.
+*
+* \param ptrTag
+* Output parameter contains the tag which identifies the command in
+* Cy_PdStack_Dpm_CancelPdCommand. The tag is not reused while the command is
+* queued or handed to the stack. Can be NULL.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the command is queued.
+* CY_PDSTACK_STAT_BUSY if the queue is full.
+* CY_PDSTACK_STAT_BAD_PARAM if any of the parameters are invalid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_QueuePdCommand(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_dpm_pd_cmd_t cmd,
+        const cy_stc_pdstack_dpm_pd_cmd_buf_t *ptrCmdBuf,
+        cy_pdstack_dpm_pd_cmd_cbk_t cmdCbk,
+        uint8_t priority,
+        uint8_t *ptrTag);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_CancelPdCommand
+****************************************************************************//**
+*
+* Removes a queued command which has not been started yet. The callback of
+* the command is invoked with CY_PDSTACK_SEQ_ABORTED.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param tag
+* Tag returned by Cy_PdStack_Dpm_QueuePdCommand.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the command has been cancelled.
+* CY_PDSTACK_STAT_BUSY if the command has already been handed to the stack.
+* CY_PDSTACK_STAT_INVALID_ARGUMENT if no command with this tag is queued.
+* CY_PDSTACK_STAT_BAD_PARAM if the context pointer is invalid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_CancelPdCommand(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        uint8_t tag);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_FlushPdCommands
+****************************************************************************//**
+*
+* Cancels all queued commands of the port and releases the command handed to
+* the stack, whose later completion is then dropped. The callback of each
+* command, the released one first, is invoked with CY_PDSTACK_SEQ_ABORTED.
+* Cy_PdStack_Dpm_CmdQueueEventHandler calls this on disconnect, hard reset and
+* policy engine disable.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the context pointer is invalid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_FlushPdCommands(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_CmdQueueTask
+****************************************************************************//**
+*
+* Starts the next queued command if the stack can accept one. A command which
+* the stack rejects is completed with CY_PDSTACK_CMD_FAILED and the next
+* command is tried in the same call. Must be called
+* from the same context as Cy_PdStack_Dpm_Task, after it.
+* Cy_PdStack_Dpm_TaskPending does this automatically.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the context pointer is invalid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_CmdQueueTask(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_CmdQueueGetCount
+****************************************************************************//**
+*
+* Returns the number of commands waiting to be started on the port.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* Number of queued commands. Zero if the context pointer is invalid.
+*
+*******************************************************************************/
+uint8_t Cy_PdStack_Dpm_CmdQueueGetCount(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_CmdQueueEventHandler
+****************************************************************************//**
+*
+* Application event hook of the command queue. Must be called from the
+* app_event_handler callback of the application.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param evt
+* Type of application event.
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_CmdQueueEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_DPM_QUEUE_H */
+
+/* [] END OF FILE */
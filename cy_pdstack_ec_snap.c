@@ -0,0 +1,211 @@
+/***************************************************************************//**
+* \file cy_pdstack_ec_snap.c
+* \version 4.0
+*
+* Source file of the embedded controller status snapshot of the PDStack
+* middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "cy_syslib.h"
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_dpm.h"
+#include "cy_pdstack_ec_snap.h"
+
+#if (CY_PD_EC_SNAPSHOT_ENABLE)
+
+static void ec_snap_read(cy_stc_pdstack_context_t *ptrPdStackContext, cy_stc_pdstack_ec_port_snap_t *ptrPort)
+{
+    uint8_t flags = 0u;
+
+    ptrPort->portStatus      = Cy_PdStack_Dpm_GetPdPortStatus(ptrPdStackContext);
+    ptrPort->powerStatus     = ptrPdStackContext->dpmStat.portStatus;
+    ptrPort->vbusVolt        = Cy_PdStack_Dpm_GetVbusVoltage(ptrPdStackContext);
+    ptrPort->contractCur     = ptrPdStackContext->dpmStat.contract.curPwr;
+    ptrPort->contractMaxVolt = ptrPdStackContext->dpmStat.contract.maxVolt;
+    ptrPort->contractMinVolt = ptrPdStackContext->dpmStat.contract.minVolt;
+    ptrPort->typecState      = (uint8_t)ptrPdStackContext->dpmStat.typecFsmState;
+    ptrPort->peState         = (uint8_t)ptrPdStackContext->dpmStat.peFsmState;
+    ptrPort->cableUsbSig     = (uint8_t)Cy_PdStack_Dpm_GetCableUsbCap(ptrPdStackContext);
+
+    if (ptrPdStackContext->dpmConfig.attach)
+    {
+        flags |= CY_PDSTACK_EC_FLAG_ATTACHED;
+    }
+    if (ptrPdStackContext->dpmConfig.contractExist)
+    {
+        flags |= CY_PDSTACK_EC_FLAG_CONTRACT;
+    }
+    if (CY_PDSTACK_CFG_EPR_ACTIVE(ptrPdStackContext))
+    {
+        flags |= CY_PDSTACK_EC_FLAG_EPR_ACTIVE;
+    }
+    if (ptrPdStackContext->dpmStat.pdConnected)
+    {
+        flags |= CY_PDSTACK_EC_FLAG_PD_CONNECTED;
+    }
+    ptrPort->flags = flags;
+}
+
+static uint32_t ec_snap_diff(const cy_stc_pdstack_ec_port_snap_t *ptrOld, const cy_stc_pdstack_ec_port_snap_t *ptrNew)
+{
+    uint32_t diff = 0u;
+    uint16_t vbusDelta;
+
+    if (ptrOld->portStatus != ptrNew->portStatus)
+    {
+        diff |= CY_PDSTACK_EC_CHG_PORT_STATUS;
+    }
+    if (memcmp(&ptrOld->powerStatus, &ptrNew->powerStatus, sizeof(cy_stc_pdstack_pd_power_status_t)) != 0)
+    {
+        diff |= CY_PDSTACK_EC_CHG_POWER_STATUS;
+    }
+
+    vbusDelta = (ptrOld->vbusVolt > ptrNew->vbusVolt) ? (ptrOld->vbusVolt - ptrNew->vbusVolt) :
+        (ptrNew->vbusVolt - ptrOld->vbusVolt);
+    if (vbusDelta > CY_PD_EC_SNAPSHOT_VBUS_DELTA_MV)
+    {
+        diff |= CY_PDSTACK_EC_CHG_VBUS;
+    }
+
+    if ((ptrOld->contractCur != ptrNew->contractCur) || (ptrOld->contractMaxVolt != ptrNew->contractMaxVolt) ||
+            (ptrOld->contractMinVolt != ptrNew->contractMinVolt))
+    {
+        diff |= CY_PDSTACK_EC_CHG_CONTRACT;
+    }
+    if (ptrOld->typecState != ptrNew->typecState)
+    {
+        diff |= CY_PDSTACK_EC_CHG_TYPEC_STATE;
+    }
+    if (ptrOld->peState != ptrNew->peState)
+    {
+        diff |= CY_PDSTACK_EC_CHG_PE_STATE;
+    }
+    if (ptrOld->cableUsbSig != ptrNew->cableUsbSig)
+    {
+        diff |= CY_PDSTACK_EC_CHG_CABLE;
+    }
+    if (ptrOld->flags != ptrNew->flags)
+    {
+        diff |= CY_PDSTACK_EC_CHG_FLAGS;
+    }
+
+    return diff;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_EcSnapUpdate(
+        cy_stc_pdstack_context_t * const ptrPdStackContext[],
+        uint8_t numPorts,
+        cy_stc_pdstack_ec_snapshot_t *ptrSnap,
+        bool *ptrChanged)
+{
+    cy_stc_pdstack_ec_port_snap_t cur[CY_PD_MAX_NO_OF_PORTS];
+    cy_stc_pdstack_ec_port_snap_t *ptrPort;
+    uint32_t diff;
+    uint32_t intrState;
+    bool changed = false;
+    bool init;
+    uint8_t i;
+
+    if ((ptrPdStackContext == NULL) || (ptrSnap == NULL) || (numPorts == 0u) ||
+            (numPorts > CY_PD_MAX_NO_OF_PORTS))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    for (i = 0u; i < numPorts; i++)
+    {
+        if (ptrPdStackContext[i] == NULL)
+        {
+            return CY_PDSTACK_STAT_BAD_PARAM;
+        }
+    }
+
+    /* The VBus measurement goes through the application and may take a
+     * while, so everything is read before entering the critical section. */
+    for (i = 0u; i < numPorts; i++)
+    {
+        ec_snap_read(ptrPdStackContext[i], &cur[i]);
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    init = ((ptrSnap->version != CY_PDSTACK_EC_SNAP_VERSION) || (ptrSnap->numPorts != numPorts));
+    if (init)
+    {
+        ptrSnap->version  = CY_PDSTACK_EC_SNAP_VERSION;
+        ptrSnap->numPorts = numPorts;
+        ptrSnap->portSize = (uint16_t)sizeof(cy_stc_pdstack_ec_port_snap_t);
+    }
+
+    for (i = 0u; i < numPorts; i++)
+    {
+        ptrPort = &ptrSnap->port[i];
+        diff    = init ? CY_PDSTACK_EC_CHG_ALL : ec_snap_diff(ptrPort, &cur[i]);
+        if (diff != 0u)
+        {
+            /* A VBus drift below the threshold is not published, so that the
+             * reported value only moves together with a change bit. */
+            if ((diff & CY_PDSTACK_EC_CHG_VBUS) == 0u)
+            {
+                cur[i].vbusVolt = ptrPort->vbusVolt;
+            }
+            /* The caller's buffer holds no valid mask before it has been
+             * initialized. */
+            cur[i].changeMask = init ? CY_PDSTACK_EC_CHG_ALL : (ptrPort->changeMask | diff);
+            *ptrPort = cur[i];
+            changed  = true;
+        }
+    }
+
+    if (changed)
+    {
+        ptrSnap->seq++;
+    }
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    if (ptrChanged != NULL)
+    {
+        *ptrChanged = changed;
+    }
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_EcSnapAck(
+        cy_stc_pdstack_ec_snapshot_t *ptrSnap,
+        uint32_t seq)
+{
+    cy_en_pdstack_status_t stat = CY_PDSTACK_STAT_FAILURE;
+    uint32_t intrState;
+    uint8_t i;
+
+    if (ptrSnap == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    if (ptrSnap->seq == seq)
+    {
+        for (i = 0u; (i < ptrSnap->numPorts) && (i < CY_PD_MAX_NO_OF_PORTS); i++)
+        {
+            ptrSnap->port[i].changeMask = 0u;
+        }
+        stat = CY_PDSTACK_STAT_SUCCESS;
+    }
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return stat;
+}
+
+#endif /* (CY_PD_EC_SNAPSHOT_ENABLE) */
+
+/* [] END OF FILE */
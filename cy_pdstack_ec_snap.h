@@ -0,0 +1,188 @@
+/***************************************************************************//**
+* \file cy_pdstack_ec_snap.h
+* \version 4.0
+*
+* Header file of the embedded controller status snapshot of the PDStack
+* middleware. The status of all ports is collected into one versioned
+* structure with a sequence number and per-port change masks, which an
+* embedded controller can read in a single HPI transfer.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_EC_SNAP_H)
+#define CY_PDSTACK_EC_SNAP_H
+
+#include "cy_pdstack_common.h"
+
+/**
+* \addtogroup group_pdstack_macros
+* \{
+*/
+
+/** Layout version of cy_stc_pdstack_ec_snapshot_t. */
+#define CY_PDSTACK_EC_SNAP_VERSION              (1u)
+
+/** Change mask: portStatus. */
+#define CY_PDSTACK_EC_CHG_PORT_STATUS           (1UL << 0u)
+
+/** Change mask: powerStatus. */
+#define CY_PDSTACK_EC_CHG_POWER_STATUS          (1UL << 1u)
+
+/** Change mask: vbusVolt moved by more than CY_PD_EC_SNAPSHOT_VBUS_DELTA_MV. */
+#define CY_PDSTACK_EC_CHG_VBUS                  (1UL << 2u)
+
+/** Change mask: contract fields. */
+#define CY_PDSTACK_EC_CHG_CONTRACT              (1UL << 3u)
+
+/** Change mask: typecState. */
+#define CY_PDSTACK_EC_CHG_TYPEC_STATE           (1UL << 4u)
+
+/** Change mask: peState. */
+#define CY_PDSTACK_EC_CHG_PE_STATE              (1UL << 5u)
+
+/** Change mask: cableUsbSig. */
+#define CY_PDSTACK_EC_CHG_CABLE                 (1UL << 6u)
+
+/** Change mask: flags. */
+#define CY_PDSTACK_EC_CHG_FLAGS                 (1UL << 7u)
+
+/** Change mask: all fields, reported for every port when the snapshot is
+ * initialized. */
+#define CY_PDSTACK_EC_CHG_ALL                                                   \
+    (CY_PDSTACK_EC_CHG_PORT_STATUS | CY_PDSTACK_EC_CHG_POWER_STATUS |          \
+     CY_PDSTACK_EC_CHG_VBUS | CY_PDSTACK_EC_CHG_CONTRACT |                     \
+     CY_PDSTACK_EC_CHG_TYPEC_STATE | CY_PDSTACK_EC_CHG_PE_STATE |              \
+     CY_PDSTACK_EC_CHG_CABLE | CY_PDSTACK_EC_CHG_FLAGS)
+
+/** Port flag: Type-C attached. */
+#define CY_PDSTACK_EC_FLAG_ATTACHED             (0x01u)
+
+/** Port flag: explicit contract exists. */
+#define CY_PDSTACK_EC_FLAG_CONTRACT             (0x02u)
+
+/** Port flag: EPR mode active. */
+#define CY_PDSTACK_EC_FLAG_EPR_ACTIVE           (0x04u)
+
+/** Port flag: port partner is PD capable. */
+#define CY_PDSTACK_EC_FLAG_PD_CONNECTED         (0x08u)
+
+/** \} group_pdstack_macros */
+
+/**
+* \addtogroup group_pdstack_data_structures
+* \{
+*/
+
+/**
+ * @brief Snapshot of one port, 28 bytes without padding.
+ */
+typedef struct
+{
+    uint32_t                            portStatus;     /**< cy_stc_pdstack_pd_port_status_ec_t value, as reported by
+                                                             Cy_PdStack_Dpm_GetPdPortStatus. */
+    cy_stc_pdstack_pd_power_status_t    powerStatus;    /**< Port power status. */
+    uint32_t                            changeMask;     /**< CY_PDSTACK_EC_CHG_* bits of the fields changed since the
+                                                             last acknowledged snapshot. */
+    uint16_t                            vbusVolt;       /**< VBus voltage in mV. */
+    uint16_t                            contractCur;    /**< Contract current in 10 mA units, or power in 250 mW
+                                                             units for battery contracts. */
+    uint16_t                            contractMaxVolt;/**< Contract maximum voltage in mV. */
+    uint16_t                            contractMinVolt;/**< Contract minimum voltage in mV. */
+    uint8_t                             typecState;     /**< cy_en_pdstack_typec_fsm_state_t. */
+    uint8_t                             peState;        /**< cy_en_pdstack_pe_fsm_state_t. */
+    uint8_t                             cableUsbSig;    /**< cy_en_pdstack_usb_data_sig_t of the cable. */
+    uint8_t                             flags;          /**< CY_PDSTACK_EC_FLAG_* bits. */
+} cy_stc_pdstack_ec_port_snap_t;
+
+/**
+ * @brief Status snapshot of all ports. The layout is fixed, so that the
+ * structure can be exposed as an HPI register region. The embedded controller
+ * polls seq, reads the structure when it has changed and writes seq back
+ * through Cy_PdStack_Dpm_EcSnapAck to clear the change masks.
+ */
+typedef struct
+{
+    uint8_t                             version;        /**< CY_PDSTACK_EC_SNAP_VERSION. */
+    uint8_t                             numPorts;       /**< Number of valid port entries. */
+    uint16_t                            portSize;       /**< sizeof(cy_stc_pdstack_ec_port_snap_t). */
+    volatile uint32_t                   seq;            /**< Incremented on every update which changes the snapshot. */
+    cy_stc_pdstack_ec_port_snap_t       port[CY_PD_MAX_NO_OF_PORTS];    /**< Port entries. */
+} cy_stc_pdstack_ec_snapshot_t;
+
+/** \} group_pdstack_data_structures */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_EcSnapUpdate
+****************************************************************************//**
+*
+* Collects the status of the ports and publishes it in the snapshot. All
+* values are read first and then stored in one critical section, so that the
+* snapshot is always consistent across fields and ports. Intended to be called
+* from the main loop after the stack tasks.
+*
+* \param ptrPdStackContext
+* Array of PDStack library context pointers. Entry n of the array is stored in
+* port entry n of the snapshot.
+*
+* \param numPorts
+* Number of entries in the ptrPdStackContext array, at most
+* CY_PD_MAX_NO_OF_PORTS.
+*
+* \param ptrSnap
+* Snapshot to be updated.
+*
+* \param ptrChanged
+* Optional output parameter, set to true if the snapshot has changed and seq
+* has been incremented, for example to raise the HPI interrupt. Can be NULL.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_EcSnapUpdate(
+        cy_stc_pdstack_context_t * const ptrPdStackContext[],
+        uint8_t numPorts,
+        cy_stc_pdstack_ec_snapshot_t *ptrSnap,
+        bool *ptrChanged);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_EcSnapAck
+****************************************************************************//**
+*
+* Acknowledges a snapshot read by the embedded controller. The change masks
+* are cleared if the sequence number matches, that is if no update has been
+* published since the read. Can be called from the HPI interrupt.
+*
+* \param ptrSnap
+* Snapshot.
+*
+* \param seq
+* Sequence number of the snapshot read by the embedded controller.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the change masks have been cleared.
+* CY_PDSTACK_STAT_FAILURE if the snapshot has been updated since the read.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_EcSnapAck(
+        cy_stc_pdstack_ec_snapshot_t *ptrSnap,
+        uint32_t seq);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_EC_SNAP_H */
+
+/* [] END OF FILE */
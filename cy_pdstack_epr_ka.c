@@ -0,0 +1,326 @@
+/***************************************************************************//**
+* \file cy_pdstack_epr_ka.c
+* \version 4.0
+*
+* Source file of the EPR keepalive offload of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "cy_syslib.h"
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_dpm.h"
+#include "cy_pdstack_epr_ka.h"
+#include "cy_pdstack_perf.h"
+#if (CY_PD_EVENT_DRIVEN_TASK_ENABLE)
+#include "cy_pdstack_sched.h"
+#endif /* (CY_PD_EVENT_DRIVEN_TASK_ENABLE) */
+#if (CY_PD_TRACE_ENABLE)
+#include "cy_pdstack_trace.h"
+#endif /* (CY_PD_TRACE_ENABLE) */
+
+#if ((CY_PD_EPR_KA_OFFLOAD_ENABLE) && (CY_PDSTACK_CFG_SNK_SUPP) && (CY_PDSTACK_CFG_EPR_SUPP))
+
+#define KA_TIMER_ID(ptrPdStackContext)                                          \
+    ((cy_timer_id_t)(CY_PDSTACK_EPR_KA_TIMER_BASE_ID + (ptrPdStackContext)->port))
+
+/* Extended message bit of the message header. */
+#define KA_HDR_EXTD_POS                 (15u)
+
+/* Offset of the Extended Control message type in the first data object, after
+ * the extended message header. */
+#define KA_EXTD_CTRL_TYPE_POS           (16u)
+
+typedef struct
+{
+    cy_stc_pdstack_epr_ka_status_t      stat;
+    uint32_t                            dueStamp;
+    uint32_t                            ackStamp;
+    bool                                ackSeen;
+    volatile bool                       due;
+    bool                                inFlight;
+
+    /* Keepalive command, held by the stack until ka_cmd_cbk is called. */
+    cy_stc_pdstack_dpm_pd_cmd_buf_t     cmdBuf;
+} ka_port_t;
+
+static ka_port_t gl_eprKa[CY_PD_MAX_NO_OF_PORTS];
+
+static ka_port_t *ka_get(const cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    if ((ptrPdStackContext == NULL) || (ptrPdStackContext->port >= CY_PD_MAX_NO_OF_PORTS))
+    {
+        return NULL;
+    }
+
+    return &gl_eprKa[ptrPdStackContext->port];
+}
+
+static void ka_period_cbk(cy_timer_id_t id, void *callbackContext)
+{
+    cy_stc_pdstack_context_t *ptrPdStackContext = (cy_stc_pdstack_context_t *)callbackContext;
+    ka_port_t *ptrKa = ka_get(ptrPdStackContext);
+
+    if ((ptrKa == NULL) || (!ptrKa->stat.active))
+    {
+        return;
+    }
+
+#if (CY_PD_TRACE_ENABLE)
+    Cy_PdStack_Dpm_TraceWrite(ptrPdStackContext, CY_PDSTACK_TRACE_TIMER, 0u, (uint16_t)id);
+#endif /* (CY_PD_TRACE_ENABLE) */
+
+    /* No EPR_KeepAlive_Ack has been seen for a full period, so the keepalive
+     * of the stack is overdue. Restart from the expiry, so that the cadence
+     * of the stand-in keepalives does not depend on when the task gets to
+     * run. */
+    (void)Cy_PdUtils_SwTimer_Start(ptrPdStackContext->ptrTimerContext, ptrPdStackContext,
+            id, CY_PD_EPR_KA_PERIOD, ka_period_cbk);
+
+    if ((ptrKa->due) || (ptrKa->inFlight))
+    {
+        ptrKa->stat.overrunCount++;
+    }
+    else
+    {
+        ptrKa->due      = true;
+        ptrKa->dueStamp = CY_PDSTACK_GET_TIME_US();
+    }
+
+#if (CY_PD_EVENT_DRIVEN_TASK_ENABLE)
+    (void)Cy_PdStack_Dpm_SetSchedHook(CY_PDSTACK_SCHED_HOOK_EPR_KA, Cy_PdStack_Dpm_EprKaTask);
+    (void)Cy_PdStack_Dpm_SetPendingWork(ptrPdStackContext, CY_PDSTACK_PEND_EPR_KA);
+#endif /* (CY_PD_EVENT_DRIVEN_TASK_ENABLE) */
+}
+
+/* Accounts for an EPR_KeepAlive_Ack, whichever keepalive it answers, and
+ * restarts the period: the offload only sends when the stack does not. */
+static void ka_ack(cy_stc_pdstack_context_t *ptrPdStackContext, ka_port_t *ptrKa)
+{
+    uint32_t now = CY_PDSTACK_GET_TIME_US();
+    uint32_t interval;
+
+    (void)Cy_PdUtils_SwTimer_Start(ptrPdStackContext->ptrTimerContext, ptrPdStackContext,
+            KA_TIMER_ID(ptrPdStackContext), CY_PD_EPR_KA_PERIOD, ka_period_cbk);
+    ptrKa->due = false;
+
+    ptrKa->stat.ackCount++;
+    if (ptrKa->ackSeen)
+    {
+        interval = now - ptrKa->ackStamp;
+        if (interval > ptrKa->stat.maxIntervalUs)
+        {
+            ptrKa->stat.maxIntervalUs = interval;
+        }
+        if (interval > CY_PDSTACK_EPR_KA_MISS_US)
+        {
+            ptrKa->stat.missCount++;
+        }
+    }
+    ptrKa->ackStamp = now;
+    ptrKa->ackSeen  = true;
+}
+
+static bool ka_is_ack(const cy_stc_pdstack_pd_packet_t *ptrPkt)
+{
+    return ((ptrPkt->sop == CY_PD_SOP) && (((ptrPkt->hdr.val >> KA_HDR_EXTD_POS) & 0x1u) != 0u) &&
+            (ptrPkt->msg == (uint8_t)CY_PDSTACK_EXTD_MSG_EXTD_CTRL_MSG) &&
+            (((ptrPkt->dat[0].val >> KA_EXTD_CTRL_TYPE_POS) & 0xFFu) == (uint32_t)CY_PDSTACK_EPR_KEEP_ALIVE_ACK));
+}
+
+static void ka_cmd_cbk(cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_resp_status_t resp, const cy_stc_pdstack_pd_packet_t *pkt_ptr)
+{
+    ka_port_t *ptrKa = ka_get(ptrPdStackContext);
+
+    CY_UNUSED_PARAMETER(pkt_ptr);
+
+    if ((ptrKa == NULL) || (resp == CY_PDSTACK_CMD_SENT))
+    {
+        return;
+    }
+
+    ptrKa->inFlight = false;
+    if (resp != CY_PDSTACK_RES_RCVD)
+    {
+        ptrKa->stat.failCount++;
+        return;
+    }
+
+    if (ptrKa->stat.active)
+    {
+        ka_ack(ptrPdStackContext, ptrKa);
+    }
+}
+
+static void ka_start(cy_stc_pdstack_context_t *ptrPdStackContext, ka_port_t *ptrKa)
+{
+    if ((ptrPdStackContext->ptrTimerContext != NULL) &&
+            (Cy_PdUtils_SwTimer_Start(ptrPdStackContext->ptrTimerContext, ptrPdStackContext,
+                                      KA_TIMER_ID(ptrPdStackContext), CY_PD_EPR_KA_PERIOD, ka_period_cbk)))
+    {
+        ptrKa->stat.active = true;
+        ptrKa->due         = false;
+        ptrKa->inFlight    = false;
+        ptrKa->ackSeen     = false;
+    }
+}
+
+static void ka_stop(cy_stc_pdstack_context_t *ptrPdStackContext, ka_port_t *ptrKa)
+{
+    ptrKa->stat.active = false;
+    ptrKa->due         = false;
+    ptrKa->inFlight    = false;
+
+    if (ptrPdStackContext->ptrTimerContext != NULL)
+    {
+        Cy_PdUtils_SwTimer_Stop(ptrPdStackContext->ptrTimerContext, KA_TIMER_ID(ptrPdStackContext));
+    }
+}
+
+void Cy_PdStack_Dpm_EprKaEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data)
+{
+    ka_port_t *ptrKa = ka_get(ptrPdStackContext);
+    bool eprSink;
+
+    if (ptrKa == NULL)
+    {
+        return;
+    }
+
+    eprSink = ((ptrPdStackContext->dpmConfig.curPortRole == (uint8_t)CY_PD_PRT_ROLE_SINK) &&
+            (ptrPdStackContext->dpmConfig.contractExist) && (CY_PDSTACK_CFG_EPR_ACTIVE(ptrPdStackContext)));
+
+    switch (evt)
+    {
+        case APP_EVT_DISCONNECT:
+        case APP_EVT_HARD_RESET_RCVD:
+        case APP_EVT_HARD_RESET_SENT:
+        case APP_EVT_TYPE_C_ERROR_RECOVERY:
+        case APP_EVT_EPR_MODE_EXIT:
+            eprSink = false;
+            break;
+
+        case APP_EVT_PKT_RCVD:
+            /* Acknowledges of the keepalives sent by the stack. The response
+             * to a keepalive of the offload is accounted for by ka_cmd_cbk. */
+            if ((ptrKa->stat.active) && (!ptrKa->inFlight) && (data != NULL) &&
+                    (ka_is_ack((const cy_stc_pdstack_pd_packet_t *)data)))
+            {
+                ka_ack(ptrPdStackContext, ptrKa);
+            }
+            break;
+
+        default:
+            /* The EPR state decides. */
+            break;
+    }
+
+    if ((eprSink) && (!ptrKa->stat.active))
+    {
+        ka_start(ptrPdStackContext, ptrKa);
+    }
+    else if ((!eprSink) && (ptrKa->stat.active))
+    {
+        ka_stop(ptrPdStackContext, ptrKa);
+    }
+    else
+    {
+        /* No change. */
+    }
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_EprKaTask(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    ka_port_t *ptrKa = ka_get(ptrPdStackContext);
+    uint32_t drift;
+
+    if (ptrKa == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    if ((!ptrKa->stat.active) || (!ptrKa->due))
+    {
+        return CY_PDSTACK_STAT_SUCCESS;
+    }
+
+    ptrKa->cmdBuf.cmdSop    = CY_PD_SOP;
+    ptrKa->cmdBuf.noOfCmdDo = 0u;
+    if (Cy_PdStack_Dpm_SendPdCommand(ptrPdStackContext, CY_PDSTACK_DPM_CMD_SNK_SEND_KEEP_ALIVE,
+                &ptrKa->cmdBuf, false, ka_cmd_cbk) != CY_PDSTACK_STAT_SUCCESS)
+    {
+        /* Another AMS is running; the next task pass, which its progress
+         * triggers, retries. */
+        ptrKa->stat.deferCount++;
+        return CY_PDSTACK_STAT_BUSY;
+    }
+
+    drift = CY_PDSTACK_GET_TIME_US() - ptrKa->dueStamp;
+    ptrKa->due      = false;
+    ptrKa->inFlight = true;
+    ptrKa->stat.sentCount++;
+    ptrKa->stat.lastDriftUs = drift;
+    if (drift > ptrKa->stat.maxDriftUs)
+    {
+        ptrKa->stat.maxDriftUs = drift;
+    }
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_EprKaGetStatus(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_epr_ka_status_t *ptrStatus)
+{
+    ka_port_t *ptrKa = ka_get(ptrPdStackContext);
+    uint32_t intrState;
+
+    if ((ptrKa == NULL) || (ptrStatus == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    *ptrStatus = ptrKa->stat;
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_EprKaClearStatus(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    ka_port_t *ptrKa = ka_get(ptrPdStackContext);
+    uint32_t intrState;
+    bool active;
+
+    if (ptrKa == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    active = ptrKa->stat.active;
+    (void)memset(&ptrKa->stat, 0, sizeof(cy_stc_pdstack_epr_ka_status_t));
+    ptrKa->stat.active = active;
+    ptrKa->ackSeen     = false;
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+#endif /* ((CY_PD_EPR_KA_OFFLOAD_ENABLE) && (CY_PDSTACK_CFG_SNK_SUPP) && (CY_PDSTACK_CFG_EPR_SUPP)) */
+
+/* [] END OF FILE */
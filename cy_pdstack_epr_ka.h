@@ -0,0 +1,168 @@
+/***************************************************************************//**
+* \file cy_pdstack_epr_ka.h
+* \version 4.0
+*
+* Header file of the EPR keepalive offload of the PDStack middleware. While a
+* sink port is in EPR mode, every EPR_KeepAlive_Ack restarts a soft timer.
+* When no acknowledge is seen for CY_PD_EPR_KA_PERIOD, the keepalive of the
+* stack is overdue and the offload sends one ahead of other queued work,
+* without going through application callbacks. The keepalive timing of the
+* port is recorded in either case.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_EPR_KA_H)
+#define CY_PDSTACK_EPR_KA_H
+
+#include "cy_pdstack_common.h"
+
+/**
+* \addtogroup group_pdstack_macros
+* \{
+*/
+
+#ifndef CY_PDSTACK_EPR_KA_TIMER_BASE_ID
+/** Soft timer ID used for the keepalive cadence on port 0. Port N uses this ID
+ * plus N. Can be overridden to move the timers within the application timer
+ * range. */
+#define CY_PDSTACK_EPR_KA_TIMER_BASE_ID         (CY_PDUTILS_TIMER_APP_PORT0_START_ID + 0xE0u)
+#if (CY_PD_MAX_NO_OF_PORTS > 8u)
+#error "The default keepalive timer IDs overlap the discovery timer IDs beyond 8 ports; override CY_PDSTACK_EPR_KA_TIMER_BASE_ID."
+#endif
+#endif /* CY_PDSTACK_EPR_KA_TIMER_BASE_ID */
+
+/** Interval in us between two acknowledged keepalives above which a miss is
+ * counted: the tSinkEPRKeepAlive maximum of 500 ms. */
+#define CY_PDSTACK_EPR_KA_MISS_US               (500000u)
+
+/** \} group_pdstack_macros */
+
+/**
+* \addtogroup group_pdstack_data_structures
+* \{
+*/
+
+/**
+ * @brief EPR keepalive statistics of a port. Times are in us and stay zero
+ * unless CY_PD_PERF_GET_TIME_US is provided.
+ */
+typedef struct
+{
+    bool        active;             /**< Keepalives are being monitored. */
+    uint32_t    sentCount;          /**< Keepalives sent by the offload, because the stack's one was overdue. */
+    uint32_t    ackCount;           /**< Keepalives acknowledged by the source, from the stack or the offload. */
+    uint32_t    failCount;          /**< Keepalives of the offload not acknowledged. */
+    uint32_t    deferCount;         /**< Task passes in which the stack could not take the keepalive. */
+    uint32_t    overrunCount;       /**< Periods which expired while the previous keepalive of the offload was still pending. */
+    uint32_t    missCount;          /**< Acknowledge intervals above CY_PDSTACK_EPR_KA_MISS_US. */
+    uint32_t    lastDriftUs;        /**< Delay from the scheduled time to the send of the last keepalive. */
+    uint32_t    maxDriftUs;         /**< Largest delay from the scheduled time to the send. */
+    uint32_t    maxIntervalUs;      /**< Largest interval between two acknowledged keepalives. */
+} cy_stc_pdstack_epr_ka_status_t;
+
+/** \} group_pdstack_data_structures */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_EprKaEventHandler
+****************************************************************************//**
+*
+* Starts monitoring the keepalives when the port is an EPR sink and stops it
+* when EPR mode is left, the port is detached or reset. APP_EVT_PKT_RCVD
+* events carrying an EPR_KeepAlive_Ack restart the period. To be called from
+* the application event handler; the EPR state is checked on every event.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param evt
+* Event ID.
+*
+* \param data
+* Event data.
+*
+* \return
+* None
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_EprKaEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_EprKaTask
+****************************************************************************//**
+*
+* Sends a keepalive when the one of the stack is overdue. Called from the event-driven scheduler right after
+* the stack task and before any other deferred work so that the keepalive
+* takes the next free AMS slot, or from the main loop otherwise. A due
+* timer period is posted as CY_PDSTACK_PEND_EPR_KA, which
+* Cy_PdStack_Dpm_TaskAll serves in the urgency class of the protocol
+* deadlines, right after latched faults.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BUSY if a due keepalive could not be sent yet.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_EprKaTask(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_EprKaGetStatus
+****************************************************************************//**
+*
+* Reports the keepalive statistics of a port.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrStatus
+* Output parameter which receives the statistics.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_EprKaGetStatus(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_epr_ka_status_t *ptrStatus);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_EprKaClearStatus
+****************************************************************************//**
+*
+* Clears the keepalive statistics of a port.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_EprKaClearStatus(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_EPR_KA_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,305 @@
+/***************************************************************************//**
+* \file cy_pdstack_evt_coalesce.c
+* \version 4.0
+*
+* Source file of the coalesced application event delivery of the PDStack
+* middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "cy_syslib.h"
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_dpm.h"
+#include "cy_pdstack_evt_coalesce.h"
+#if (CY_PD_EVENT_DRIVEN_TASK_ENABLE)
+#include "cy_pdstack_sched.h"
+#endif /* (CY_PD_EVENT_DRIVEN_TASK_ENABLE) */
+#if (CY_PD_TRACE_ENABLE)
+#include "cy_pdstack_trace.h"
+#endif /* (CY_PD_TRACE_ENABLE) */
+
+#if (CY_PD_EVT_COALESCE_ENABLE)
+
+#define COALESCE_TIMER_ID(ptrPdStackContext)                                    \
+    ((cy_timer_id_t)(CY_PDSTACK_EVT_COALESCE_TIMER_BASE_ID + (ptrPdStackContext)->port))
+
+#define COALESCE_BIT_SET(mask, evt)                                             \
+    ((mask)[(uint32_t)(evt) >> 5u] |= (1UL << ((uint32_t)(evt) & 0x1Fu)))
+
+#define COALESCE_BIT_CLR(mask, evt)                                             \
+    ((mask)[(uint32_t)(evt) >> 5u] &= ~(1UL << ((uint32_t)(evt) & 0x1Fu)))
+
+#define COALESCE_BIT_GET(mask, evt)                                             \
+    (((mask)[(uint32_t)(evt) >> 5u] & (1UL << ((uint32_t)(evt) & 0x1Fu))) != 0u)
+
+typedef struct
+{
+    cy_stc_pdstack_evt_coalesce_cfg_t   cfg;
+    uint32_t                            syncMask[CY_PDSTACK_EVT_MASK_WORDS];
+    cy_stc_pdstack_evt_batch_t          batch;
+    volatile bool                       ready;
+    bool                                enabled;
+} coalesce_port_t;
+
+static coalesce_port_t gl_evtCoalesce[CY_PD_MAX_NO_OF_PORTS];
+
+/* Events delivered synchronously by default. */
+static const cy_en_pdstack_app_evt_t gl_evtCoalesceSyncDflt[] =
+{
+    APP_EVT_UNEXPECTED_VOLTAGE_ON_VBUS,
+    APP_EVT_TYPE_C_ERROR_RECOVERY,
+    APP_EVT_DISCONNECT,
+    APP_EVT_RP_CHANGE,
+    APP_EVT_PR_SWAP_COMPLETE,
+    APP_EVT_VCONN_SWAP_COMPLETE,
+    APP_EVT_APP_HW,
+    APP_EVT_HARD_RESET_RCVD,
+    APP_EVT_HARD_RESET_COMPLETE,
+    APP_EVT_PKT_RCVD,
+    APP_EVT_HARD_RESET_SENT,
+    APP_EVT_VBUS_OVP_FAULT,
+    APP_EVT_VBUS_OCP_FAULT,
+    APP_EVT_VCONN_OCP_FAULT,
+    APP_EVT_FR_SWAP_COMPLETE,
+    APP_EVT_TEMPERATURE_FAULT,
+    APP_EVT_HANDLE_EXTENDED_MSG,
+    APP_EVT_VBUS_UVP_FAULT,
+    APP_EVT_VBUS_SCP_FAULT,
+    APP_EVT_TYPEC_RP_DETACH,
+    APP_EVT_CC_OVP,
+    APP_EVT_SBU_OVP,
+    APP_EVT_ALERT_RECEIVED,
+    APP_EVT_VBUS_RCP_FAULT,
+    APP_EVT_DATA_RESET_RCVD,
+    APP_EVT_DATA_RESET_SENT,
+    APP_EVT_DATA_RESET_ACCEPTED,
+    APP_EVT_CONFIG_ERROR,
+    APP_EVT_POWER_CYCLE,
+    APP_EVT_VBUS_IN_UVP_FAULT,
+    APP_EVT_VBUS_IN_OVP_FAULT,
+    APP_EVT_SYSTEM_OT_FAULT,
+    APP_EVT_HR_PSRC_ENABLE,
+    APP_EVT_PR_SWAP_ACCEPTED,
+    APP_EVT_HR_SENT_RCVD_DEFERRED,
+    APP_EVT_SNK_FET_ENABLE,
+    APP_EVT_SNK_FET_DISABLE,
+    APP_EVT_SAFE_PWR_ENABLE,
+    APP_EVT_SAFE_PWR_DISABLE,
+    APP_EVT_VBAT_GND_SCP_FAULT,
+    APP_EVT_VIN_UVP_FAULT,
+    APP_EVT_VIN_OVP_FAULT,
+    APP_EVT_ILIM_FAULT,
+    APP_EVT_VREG_INRUSH_FAULT,
+    APP_EVT_VREG_BOD_FAULT,
+    APP_EVT_VCONN_SCP_FAULT,
+    APP_EVT_VCONN_SWAP_FAILED,
+    APP_EVT_CORROSION_FAULT
+};
+
+static coalesce_port_t *coalesce_get(const cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    if ((ptrPdStackContext == NULL) || (ptrPdStackContext->port >= CY_PD_MAX_NO_OF_PORTS))
+    {
+        return NULL;
+    }
+
+    return &gl_evtCoalesce[ptrPdStackContext->port];
+}
+
+static void coalesce_kick(cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+#if (CY_PD_EVENT_DRIVEN_TASK_ENABLE)
+    (void)Cy_PdStack_Dpm_SetSchedHook(CY_PDSTACK_SCHED_HOOK_EVT_COALESCE, Cy_PdStack_Dpm_EvtCoalesceTask);
+    (void)Cy_PdStack_Dpm_SetPendingWork(ptrPdStackContext, CY_PDSTACK_PEND_APP);
+#else
+    CY_UNUSED_PARAMETER(ptrPdStackContext);
+#endif /* (CY_PD_EVENT_DRIVEN_TASK_ENABLE) */
+}
+
+static void coalesce_quiet_cbk(cy_timer_id_t id, void *callbackContext)
+{
+    cy_stc_pdstack_context_t *ptrPdStackContext = (cy_stc_pdstack_context_t *)callbackContext;
+    coalesce_port_t *ptrPort = coalesce_get(ptrPdStackContext);
+
+    CY_UNUSED_PARAMETER(id);
+
+    if (ptrPort != NULL)
+    {
+#if (CY_PD_TRACE_ENABLE)
+        Cy_PdStack_Dpm_TraceWrite(ptrPdStackContext, CY_PDSTACK_TRACE_TIMER, 0u, (uint16_t)id);
+#endif /* (CY_PD_TRACE_ENABLE) */
+        ptrPort->ready = true;
+        coalesce_kick(ptrPdStackContext);
+    }
+}
+
+/* Takes the pending batch, if any, and passes it to the batch handler. */
+static void coalesce_deliver(cy_stc_pdstack_context_t *ptrPdStackContext, coalesce_port_t *ptrPort)
+{
+    cy_stc_pdstack_evt_batch_t batch;
+    uint32_t intrState;
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    batch = ptrPort->batch;
+    (void)memset(&ptrPort->batch, 0, sizeof(cy_stc_pdstack_evt_batch_t));
+    ptrPort->ready = false;
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    if ((ptrPort->cfg.quietMs != 0u) && (ptrPdStackContext->ptrTimerContext != NULL))
+    {
+        Cy_PdUtils_SwTimer_Stop(ptrPdStackContext->ptrTimerContext, COALESCE_TIMER_ID(ptrPdStackContext));
+    }
+
+    if (batch.evtCount != 0u)
+    {
+        ptrPort->cfg.batchHandler(ptrPdStackContext, &batch);
+    }
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_EvtCoalesceInit(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        const cy_stc_pdstack_evt_coalesce_cfg_t *ptrCfg)
+{
+    coalesce_port_t *ptrPort = coalesce_get(ptrPdStackContext);
+    uint8_t i;
+
+    if ((ptrPort == NULL) || (ptrCfg == NULL) || (ptrCfg->batchHandler == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    (void)memset(ptrPort, 0, sizeof(coalesce_port_t));
+    ptrPort->cfg = *ptrCfg;
+    for (i = 0u; i < (uint8_t)(sizeof(gl_evtCoalesceSyncDflt) / sizeof(gl_evtCoalesceSyncDflt[0])); i++)
+    {
+        COALESCE_BIT_SET(ptrPort->syncMask, gl_evtCoalesceSyncDflt[i]);
+    }
+    ptrPort->enabled = true;
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_EvtCoalesceSetSync(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        bool sync)
+{
+    coalesce_port_t *ptrPort = coalesce_get(ptrPdStackContext);
+
+    if ((ptrPort == NULL) || (!ptrPort->enabled) || (evt >= APP_TOTAL_EVENTS))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    if (sync)
+    {
+        COALESCE_BIT_SET(ptrPort->syncMask, evt);
+    }
+    else
+    {
+        COALESCE_BIT_CLR(ptrPort->syncMask, evt);
+    }
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+void Cy_PdStack_Dpm_EvtCoalesceHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *dat)
+{
+    coalesce_port_t *ptrPort = coalesce_get(ptrPdStackContext);
+    uint32_t intrState;
+
+    if ((ptrPort == NULL) || (!ptrPort->enabled) || (evt >= APP_TOTAL_EVENTS))
+    {
+        return;
+    }
+
+    if (COALESCE_BIT_GET(ptrPort->syncMask, evt))
+    {
+        /* Deliver what happened before, so that the order is kept. */
+        coalesce_deliver(ptrPdStackContext, ptrPort);
+        if (ptrPort->cfg.syncHandler != NULL)
+        {
+            ptrPort->cfg.syncHandler(ptrPdStackContext, evt, dat);
+        }
+        return;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    COALESCE_BIT_SET(ptrPort->batch.evtMask, evt);
+    if (ptrPort->batch.evtCount != 0xFFFFu)
+    {
+        ptrPort->batch.evtCount++;
+    }
+    if ((evt == APP_EVT_PD_CONTRACT_NEGOTIATION_COMPLETE) && (dat != NULL))
+    {
+        ptrPort->batch.contract      = *(const cy_stc_pdstack_pd_contract_info_t *)dat;
+        ptrPort->batch.contractValid = true;
+    }
+    ptrPort->ready = false;
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    /* Every new event restarts the quiet time. */
+    if ((ptrPort->cfg.quietMs != 0u) && (ptrPdStackContext->ptrTimerContext != NULL))
+    {
+        if (!Cy_PdUtils_SwTimer_Start(ptrPdStackContext->ptrTimerContext, ptrPdStackContext,
+                    COALESCE_TIMER_ID(ptrPdStackContext), ptrPort->cfg.quietMs, coalesce_quiet_cbk))
+        {
+            /* No timer: fall back to delivery from the next task pass. */
+            ptrPort->ready = true;
+        }
+    }
+    coalesce_kick(ptrPdStackContext);
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_EvtCoalesceTask(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    coalesce_port_t *ptrPort = coalesce_get(ptrPdStackContext);
+
+    if (ptrPort == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    if ((!ptrPort->enabled) || (ptrPort->batch.evtCount == 0u))
+    {
+        return CY_PDSTACK_STAT_SUCCESS;
+    }
+
+    if ((ptrPort->cfg.quietMs != 0u) && (ptrPdStackContext->ptrTimerContext != NULL) && (!ptrPort->ready))
+    {
+        return CY_PDSTACK_STAT_BUSY;
+    }
+
+    coalesce_deliver(ptrPdStackContext, ptrPort);
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_EvtCoalesceFlush(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    coalesce_port_t *ptrPort = coalesce_get(ptrPdStackContext);
+
+    if ((ptrPort == NULL) || (!ptrPort->enabled))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    coalesce_deliver(ptrPdStackContext, ptrPort);
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+#endif /* (CY_PD_EVT_COALESCE_ENABLE) */
+
+/* [] END OF FILE */
@@ -0,0 +1,228 @@
+/***************************************************************************//**
+* \file cy_pdstack_evt_coalesce.h
+* \version 4.0
+*
+* Header file of the coalesced application event delivery of the PDStack
+* middleware. Application events which only update the application view of
+* the port (display, LEDs, embedded controller notification) are collected
+* into a per-port batch and delivered once per task pass or after a quiet
+* time, while power safety related events stay synchronous.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_EVT_COALESCE_H)
+#define CY_PDSTACK_EVT_COALESCE_H
+
+#include "cy_pdstack_common.h"
+
+/**
+* \addtogroup group_pdstack_macros
+* \{
+*/
+
+#ifndef CY_PDSTACK_EVT_COALESCE_TIMER_BASE_ID
+/** Soft timer ID used for the quiet time on port 0. Port N uses this ID plus
+ * N. Can be overridden to move the timers within the application timer range. */
+#define CY_PDSTACK_EVT_COALESCE_TIMER_BASE_ID   (CY_PDUTILS_TIMER_APP_PORT0_START_ID + 0xF8u)
+#if (CY_PD_MAX_NO_OF_PORTS > 8u)
+#error "The default event coalescing timer IDs leave the first 256 application timer IDs beyond 8 ports; override CY_PDSTACK_EVT_COALESCE_TIMER_BASE_ID."
+#endif
+#endif /* CY_PDSTACK_EVT_COALESCE_TIMER_BASE_ID */
+
+/** Number of 32-bit words of the event mask of a batch. */
+#define CY_PDSTACK_EVT_MASK_WORDS               (((uint32_t)APP_TOTAL_EVENTS + 31u) / 32u)
+
+/** Evaluates to true if event evt is set in batch ptrBatch. */
+#define CY_PDSTACK_EVT_BATCH_IS_SET(ptrBatch, evt)                              \
+    ((((ptrBatch)->evtMask[(uint32_t)(evt) >> 5u]) & (1UL << ((uint32_t)(evt) & 0x1Fu))) != 0u)
+
+/** \} group_pdstack_macros */
+
+/**
+* \addtogroup group_pdstack_data_structures
+* \{
+*/
+
+/**
+ * @brief Batch of coalesced application events of a port. Each event is
+ * reported once, however often it was raised since the previous batch.
+ */
+typedef struct
+{
+    uint32_t                            evtMask[CY_PDSTACK_EVT_MASK_WORDS]; /**< Set of events, bit n for
+                                                                                 cy_en_pdstack_app_evt_t n. */
+    uint16_t                            evtCount;       /**< Number of events raised, including repeats. */
+    bool                                contractValid;  /**< contract holds the data of the last
+                                                             APP_EVT_PD_CONTRACT_NEGOTIATION_COMPLETE. */
+    cy_stc_pdstack_pd_contract_info_t   contract;       /**< Contract information. */
+} cy_stc_pdstack_evt_batch_t;
+
+/**
+ * @brief Callback which receives a batch of coalesced events.
+ */
+typedef void (*cy_pdstack_evt_batch_cbk_t)(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        const cy_stc_pdstack_evt_batch_t *ptrBatch);
+
+/**
+ * @brief Configuration of the coalesced event delivery of a port.
+ */
+typedef struct
+{
+    /** Event handler of the application, called directly for the synchronous
+     * events. Usually the handler set in the application callback structure
+     * before it was replaced by Cy_PdStack_Dpm_EvtCoalesceHandler. */
+    void (*syncHandler)(cy_stc_pdstack_context_t *ptrPdStackContext,
+            cy_en_pdstack_app_evt_t evt, const void *dat);
+
+    /** Handler which receives the batches. Must not be NULL. */
+    cy_pdstack_evt_batch_cbk_t          batchHandler;
+
+    /** Time in ms without new events before a batch is delivered. With zero
+     * a batch is delivered from every task pass which finds events. */
+    uint16_t                            quietMs;
+} cy_stc_pdstack_evt_coalesce_cfg_t;
+
+/** \} group_pdstack_data_structures */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_EvtCoalesceInit
+****************************************************************************//**
+*
+* Enables the coalesced event delivery of a port. The synchronous event set
+* is reset to the default, which holds the fault events, the hard reset,
+* disconnect and error recovery events, the Rp events which change the sink
+* current limit (APP_EVT_RP_CHANGE, APP_EVT_TYPEC_RP_DETACH), the power path
+* events (APP_EVT_HR_PSRC_ENABLE, APP_EVT_SNK_FET_*, APP_EVT_SAFE_PWR_*), the
+* power role and VConn swap events (APP_EVT_PR_SWAP_ACCEPTED,
+* APP_EVT_PR_SWAP_COMPLETE, APP_EVT_FR_SWAP_COMPLETE,
+* APP_EVT_VCONN_SWAP_COMPLETE, APP_EVT_VCONN_SWAP_FAILED), the data reset
+* events, APP_EVT_APP_HW and
+* the events which carry a message to be handled (APP_EVT_PKT_RCVD,
+* APP_EVT_HANDLE_EXTENDED_MSG and APP_EVT_ALERT_RECEIVED).
+*
+* The application then sets Cy_PdStack_Dpm_EvtCoalesceHandler as
+* app_event_handler of the port.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrCfg
+* Configuration. Copied by the function.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_EvtCoalesceInit(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        const cy_stc_pdstack_evt_coalesce_cfg_t *ptrCfg);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_EvtCoalesceSetSync
+****************************************************************************//**
+*
+* Adds an event to or removes it from the synchronous event set of a port.
+* Events whose data is needed by the application, and which are not carried
+* by the batch, are to be made synchronous.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param evt
+* Event ID.
+*
+* \param sync
+* true to deliver the event synchronously.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_EvtCoalesceSetSync(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        bool sync);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_EvtCoalesceHandler
+****************************************************************************//**
+*
+* Application event handler of the coalesced delivery. Synchronous events are
+* passed to the syncHandler at once, after the pending batch, so that the
+* application sees the events in order. Other events are added to the batch
+* and the quiet time is restarted.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param evt
+* Event ID.
+*
+* \param dat
+* Event data.
+*
+* \return
+* None
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_EvtCoalesceHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *dat);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_EvtCoalesceTask
+****************************************************************************//**
+*
+* Delivers the pending batch of a port once the quiet time has expired, or at
+* once if the quiet time is zero. Called from the event-driven scheduler after
+* the stack task, or from the main loop otherwise.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if a batch was delivered or nothing is pending.
+* CY_PDSTACK_STAT_BUSY if a batch is held back by the quiet time.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_EvtCoalesceTask(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_EvtCoalesceFlush
+****************************************************************************//**
+*
+* Delivers the pending batch of a port at once, regardless of the quiet time.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_EvtCoalesceFlush(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_EVT_COALESCE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,286 @@
+/***************************************************************************//**
+* \file cy_pdstack_extd_msg.c
+* \version 4.0
+*
+* Source file of the extended message receive interface of the PDStack
+* middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_dpm.h"
+#include "cy_pdstack_extd_msg.h"
+
+#if (CY_PD_EXTD_MSG_VIEW_ENABLE)
+
+/* Extended bit position in the PD message header. */
+#define EXTD_MSG_HDR_EXTD_POS           (15u)
+
+/* Size of the extended header which precedes the payload in the packet. */
+#define EXTD_MSG_EXTD_HDR_SIZE          (2u)
+
+/* Index value returned when no registration matches. */
+#define EXTD_MSG_NO_REG                 (0xFFu)
+
+typedef struct
+{
+    uint8_t                    *ptrBuf;
+    uint16_t                    bufSize;
+    cy_en_pdstack_extd_msg_t    msgType;
+    cy_pdstack_extd_msg_cbk_t   cbk;
+} extd_rx_reg_t;
+
+typedef struct
+{
+    extd_rx_reg_t               reg[CY_PD_EXTD_RX_BUF_COUNT];
+    uint8_t                     activeReg;      /* Registration index + 1, zero when idle. */
+    uint8_t                     nextChunk;
+    uint16_t                    dataSize;
+    cy_en_pd_sop_t              sop;
+} extd_rx_port_t;
+
+static extd_rx_port_t gl_extdRx[CY_PD_MAX_NO_OF_PORTS];
+
+/* Chunk requests carry no payload; the stack still expects an aligned buffer. */
+static uint32_t gl_extdChunkReqPad;
+
+static extd_rx_port_t *extd_rx_get(const cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    if ((ptrPdStackContext == NULL) || (ptrPdStackContext->port >= CY_PD_MAX_NO_OF_PORTS))
+    {
+        return NULL;
+    }
+
+    return &gl_extdRx[ptrPdStackContext->port];
+}
+
+static uint8_t extd_rx_find(const extd_rx_port_t *ptrPort, cy_en_pdstack_extd_msg_t msgType)
+{
+    uint8_t i;
+
+    for (i = 0u; i < CY_PD_EXTD_RX_BUF_COUNT; i++)
+    {
+        if ((ptrPort->reg[i].ptrBuf != NULL) && (ptrPort->reg[i].msgType == msgType))
+        {
+            return i;
+        }
+    }
+
+    return EXTD_MSG_NO_REG;
+}
+
+static cy_en_pdstack_status_t extd_rx_request_chunk(cy_stc_pdstack_context_t *ptrPdStackContext,
+        const extd_rx_port_t *ptrPort, cy_en_pdstack_extd_msg_t msgType)
+{
+    cy_stc_pdstack_dpm_pd_cmd_buf_t cmdBuf;
+
+    (void)memset(&cmdBuf, 0, sizeof(cmdBuf));
+    cmdBuf.cmdSop                = ptrPort->sop;
+    cmdBuf.extdType              = msgType;
+    cmdBuf.extdHdr.extd.chunked  = 1u;
+    cmdBuf.extdHdr.extd.request  = 1u;
+    cmdBuf.extdHdr.extd.chunkNum = ptrPort->nextChunk;
+    cmdBuf.extdHdr.extd.dataSize = 0u;
+    cmdBuf.noOfCmdDo             = 1u;
+    cmdBuf.datPtr                = (uint8_t *)&gl_extdChunkReqPad;
+
+    (void)Cy_PdStack_Dpm_SetChunkXferRunning(ptrPdStackContext, CY_PDSTACK_AMS_NON_INTR);
+    return Cy_PdStack_Dpm_SendPdCommand(ptrPdStackContext, CY_PDSTACK_DPM_CMD_SEND_EXTENDED,
+            &cmdBuf, true, NULL);
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_RegisterExtdRxBuffer(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_extd_msg_t msgType,
+        uint8_t *ptrBuf,
+        uint16_t bufSize,
+        cy_pdstack_extd_msg_cbk_t cbk)
+{
+    extd_rx_port_t *ptrPort = extd_rx_get(ptrPdStackContext);
+    uint8_t idx;
+
+    if ((ptrPort == NULL) || ((ptrBuf != NULL) && ((bufSize == 0u) || (cbk == NULL))))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    idx = extd_rx_find(ptrPort, msgType);
+
+    if (ptrBuf == NULL)
+    {
+        if (idx != EXTD_MSG_NO_REG)
+        {
+            if (ptrPort->activeReg == (idx + 1u))
+            {
+                ptrPort->activeReg = 0u;
+            }
+            ptrPort->reg[idx].ptrBuf = NULL;
+        }
+        return CY_PDSTACK_STAT_SUCCESS;
+    }
+
+    if (idx == EXTD_MSG_NO_REG)
+    {
+        for (idx = 0u; idx < CY_PD_EXTD_RX_BUF_COUNT; idx++)
+        {
+            if (ptrPort->reg[idx].ptrBuf == NULL)
+            {
+                break;
+            }
+        }
+        if (idx == CY_PD_EXTD_RX_BUF_COUNT)
+        {
+            return CY_PDSTACK_STAT_BUSY;
+        }
+    }
+
+    ptrPort->reg[idx].ptrBuf  = ptrBuf;
+    ptrPort->reg[idx].bufSize = bufSize;
+    ptrPort->reg[idx].msgType = msgType;
+    ptrPort->reg[idx].cbk     = cbk;
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_ExtdMsgHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        const cy_stc_pdstack_pd_packet_t *ptrPkt,
+        bool *ptrHandled)
+{
+    extd_rx_port_t *ptrPort = extd_rx_get(ptrPdStackContext);
+    const extd_rx_reg_t *ptrReg;
+    cy_stc_pdstack_extd_msg_view_t view;
+    cy_pdstack_extd_hdr_t extdHdr;
+    cy_en_pdstack_extd_msg_t msgType;
+    const uint8_t *ptrPayload;
+    uint16_t offset;
+    uint16_t len;
+    uint8_t idx;
+
+    if ((ptrPort == NULL) || (ptrPkt == NULL) || (ptrHandled == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    *ptrHandled = false;
+
+    if (((ptrPkt->hdr.val >> EXTD_MSG_HDR_EXTD_POS) & 0x1u) == 0u)
+    {
+        return CY_PDSTACK_STAT_SUCCESS;
+    }
+
+    /* The extended header occupies the lower half of the first data object
+     * and the payload follows it. */
+    extdHdr.val = (uint16_t)(ptrPkt->dat[0].val & 0xFFFFu);
+    msgType     = (cy_en_pdstack_extd_msg_t)ptrPkt->msg;
+    ptrPayload  = ((const uint8_t *)&ptrPkt->dat[0]) + EXTD_MSG_EXTD_HDR_SIZE;
+
+    /* Chunk requests belong to a transmit sequence. */
+    if (extdHdr.extd.request != 0u)
+    {
+        return CY_PDSTACK_STAT_SUCCESS;
+    }
+
+    idx = extd_rx_find(ptrPort, msgType);
+    if (idx == EXTD_MSG_NO_REG)
+    {
+        return CY_PDSTACK_STAT_SUCCESS;
+    }
+    ptrReg = &ptrPort->reg[idx];
+
+    view.sop     = ptrPkt->sop;
+    view.msgType = msgType;
+
+    /* Message completely contained in this packet: view it in place. */
+    if ((extdHdr.extd.chunked == 0u) || (extdHdr.extd.dataSize <= CY_PD_MAX_EXTD_MSG_LEGACY_LEN))
+    {
+        len = extdHdr.extd.dataSize;
+        if (len > (sizeof(ptrPkt->dat) - EXTD_MSG_EXTD_HDR_SIZE))
+        {
+            return CY_PDSTACK_STAT_SUCCESS;
+        }
+
+        view.ptrData  = ptrPayload;
+        view.dataSize = len;
+        ptrPort->activeReg = 0u;
+        ptrReg->cbk(ptrPdStackContext, &view);
+        *ptrHandled = true;
+        return CY_PDSTACK_STAT_SUCCESS;
+    }
+
+    if (extdHdr.extd.dataSize > ptrReg->bufSize)
+    {
+        return CY_PDSTACK_STAT_SUCCESS;
+    }
+
+    if (extdHdr.extd.chunkNum == 0u)
+    {
+        ptrPort->activeReg = idx + 1u;
+        ptrPort->nextChunk = 0u;
+        ptrPort->dataSize  = extdHdr.extd.dataSize;
+        ptrPort->sop       = ptrPkt->sop;
+    }
+
+    if ((ptrPort->activeReg != (idx + 1u)) || (ptrPort->nextChunk != extdHdr.extd.chunkNum) ||
+            (ptrPort->sop != ptrPkt->sop) || (ptrPort->dataSize != extdHdr.extd.dataSize))
+    {
+        /* Out of sequence chunk; let the application respond to it. */
+        ptrPort->activeReg = 0u;
+        return CY_PDSTACK_STAT_SUCCESS;
+    }
+
+    offset = (uint16_t)extdHdr.extd.chunkNum * CY_PD_MAX_EXTD_MSG_LEGACY_LEN;
+    len    = ptrPort->dataSize - offset;
+    if (len > CY_PD_MAX_EXTD_MSG_LEGACY_LEN)
+    {
+        len = CY_PD_MAX_EXTD_MSG_LEGACY_LEN;
+    }
+
+    /* Chunk payload goes straight to its final position in the buffer. */
+    (void)memcpy(&ptrReg->ptrBuf[offset], ptrPayload, len);
+    *ptrHandled = true;
+
+    if ((offset + len) >= ptrPort->dataSize)
+    {
+        ptrPort->activeReg = 0u;
+        view.ptrData  = ptrReg->ptrBuf;
+        view.dataSize = ptrPort->dataSize;
+        ptrReg->cbk(ptrPdStackContext, &view);
+    }
+    else
+    {
+        ptrPort->nextChunk++;
+        if (extd_rx_request_chunk(ptrPdStackContext, ptrPort, msgType) != CY_PDSTACK_STAT_SUCCESS)
+        {
+            ptrPort->activeReg = 0u;
+        }
+    }
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_ExtdMsgReset(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    extd_rx_port_t *ptrPort = extd_rx_get(ptrPdStackContext);
+
+    if (ptrPort == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    ptrPort->activeReg = 0u;
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+#endif /* (CY_PD_EXTD_MSG_VIEW_ENABLE) */
+
+/* [] END OF FILE */
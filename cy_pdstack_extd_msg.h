@@ -0,0 +1,154 @@
+/***************************************************************************//**
+* \file cy_pdstack_extd_msg.h
+* \version 4.0
+*
+* Header file of the extended message receive interface of the PDStack
+* middleware. Extended messages are delivered to the application as views on
+* either the received packet or an application-owned reassembly buffer.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_EXTD_MSG_H)
+#define CY_PDSTACK_EXTD_MSG_H
+
+#include "cy_pdstack_common.h"
+
+/*******************************************************************************
+*                              Type definitions
+*******************************************************************************/
+
+/**
+* \addtogroup group_pdstack_data_structures
+* \{
+*/
+
+/**
+ * @brief View on a received extended message. The data pointer references
+ * either the packet owned by the stack (single chunk messages) or the
+ * application buffer registered for the message type (multi-chunk messages).
+ * No copy of the payload is made for the view.
+ */
+typedef struct
+{
+    cy_en_pd_sop_t              sop;        /**< SOP type on which the message was received. */
+    cy_en_pdstack_extd_msg_t    msgType;    /**< Extended message type. */
+    const uint8_t              *ptrData;    /**< Pointer to the message payload (after the extended header). */
+    uint16_t                    dataSize;   /**< Payload size in bytes. */
+} cy_stc_pdstack_extd_msg_view_t;
+
+/**
+ * @brief Extended message receive callback. The view is only valid for the
+ * duration of the callback when it references the packet owned by the stack.
+ *
+ * @param ptrPdStackContext PD stack context.
+ * @param ptrView Pointer to the message view.
+ */
+typedef void (*cy_pdstack_extd_msg_cbk_t)(
+        struct cy_stc_pdstack_context *ptrPdStackContext,
+        const cy_stc_pdstack_extd_msg_view_t *ptrView);
+
+/** \} group_pdstack_data_structures */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_RegisterExtdRxBuffer
+****************************************************************************//**
+*
+* Registers an application-owned buffer and callback for an extended message
+* type. Chunks of a message of this type are written directly to their final
+* position in the buffer, and the callback is invoked with a view on the buffer
+* once the last chunk has been received. Passing a NULL buffer removes the
+* registration.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param msgType
+* Extended message type.
+*
+* \param ptrBuf
+* Pointer to the reassembly buffer. The buffer must remain valid while it is
+* registered.
+*
+* \param bufSize
+* Size of the buffer in bytes. Messages larger than this are passed on to the
+* application unhandled.
+*
+* \param cbk
+* Callback invoked with the reassembled message.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BUSY if all registration slots are in use.
+* CY_PDSTACK_STAT_BAD_PARAM if any of the parameters are invalid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_RegisterExtdRxBuffer(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_extd_msg_t msgType,
+        uint8_t *ptrBuf,
+        uint16_t bufSize,
+        cy_pdstack_extd_msg_cbk_t cbk);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_ExtdMsgHandler
+****************************************************************************//**
+*
+* Handles a received extended message for which a buffer has been registered.
+* Must be called from the app_event_handler callback for the
+* APP_EVT_HANDLE_EXTENDED_MSG event with the packet passed along with the
+* event. Requests for further chunks are sent by this function.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrPkt
+* Pointer to the received packet.
+*
+* \param ptrHandled
+* Output parameter contains true if the message has been consumed, false if
+* the application needs to handle the message itself.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if any of the parameters are invalid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_ExtdMsgHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        const cy_stc_pdstack_pd_packet_t *ptrPkt,
+        bool *ptrHandled);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_ExtdMsgReset
+****************************************************************************//**
+*
+* Aborts any extended message reassembly in progress on the port. Should be
+* called on disconnect, hard reset and soft reset.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the context pointer is invalid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_ExtdMsgReset(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_EXTD_MSG_H */
+
+/* [] END OF FILE */
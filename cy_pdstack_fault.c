@@ -0,0 +1,352 @@
+/***************************************************************************//**
+* \file cy_pdstack_fault.c
+* \version 4.0
+*
+* Source file of the fast VBus fault response of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include "cy_syslib.h"
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_dpm.h"
+#include "cy_pdstack_fault.h"
+#include "cy_pdstack_perf.h"
+#if (CY_PD_EVENT_DRIVEN_TASK_ENABLE)
+#include "cy_pdstack_sched.h"
+#endif /* (CY_PD_EVENT_DRIVEN_TASK_ENABLE) */
+
+#if (CY_PD_FAST_FAULT_ENABLE)
+
+/* Type of Alert bits of the Alert Data Object. */
+#define FAULT_ADO_OCP                   (1UL << 26u)
+#define FAULT_ADO_OVP                   (1UL << 30u)
+
+/* Response steps of a latched fault. */
+#define FAULT_STEP_IDLE                 (0u)    /* No fault latched. */
+#define FAULT_STEP_LATCHED              (1u)    /* Reported, response not started yet. */
+#define FAULT_STEP_ALERT                (2u)    /* Alert handed to the stack. */
+#define FAULT_STEP_HARD_RESET           (3u)    /* Hard reset to be handed to the stack. */
+#define FAULT_STEP_WAIT_HR              (4u)    /* Hard reset handed to the stack, not sent yet. */
+#define FAULT_STEP_DONE                 (5u)    /* Response complete, waiting for the clear. */
+
+typedef struct
+{
+    cy_stc_pdstack_fault_stats_t        stat;
+    uint32_t                            isrStamp;
+    volatile uint8_t                    step;
+    bool                                dispatched;
+
+    /* Alert data object, read by the stack until fault_alert_cbk. */
+    cy_stc_pdstack_dpm_pd_cmd_buf_t     cmdBuf;
+} fault_port_t;
+
+static fault_port_t gl_fault[CY_PD_MAX_NO_OF_PORTS];
+
+static fault_port_t *fault_get(const cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    if ((ptrPdStackContext == NULL) || (ptrPdStackContext->port >= CY_PD_MAX_NO_OF_PORTS))
+    {
+        return NULL;
+    }
+
+    return &gl_fault[ptrPdStackContext->port];
+}
+
+static void fault_max(uint32_t *ptrLast, uint32_t *ptrMax, uint32_t value)
+{
+    *ptrLast = value;
+    if (value > *ptrMax)
+    {
+        *ptrMax = value;
+    }
+}
+
+/* Posts the response, which is served ahead of the stack task. */
+static void fault_kick(cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+#if (CY_PD_EVENT_DRIVEN_TASK_ENABLE)
+    (void)Cy_PdStack_Dpm_SetSchedHook(CY_PDSTACK_SCHED_HOOK_FAULT, Cy_PdStack_Dpm_FaultTask);
+    (void)Cy_PdStack_Dpm_SetPendingWork(ptrPdStackContext, CY_PDSTACK_PEND_FAULT);
+#else
+    CY_UNUSED_PARAMETER(ptrPdStackContext);
+#endif /* (CY_PD_EVENT_DRIVEN_TASK_ENABLE) */
+}
+
+/* Runs in interrupt context. */
+static void fault_gate(cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+#if (!(CY_PD_SINK_ONLY))
+    if (ptrPdStackContext->dpmConfig.curPortRole == (uint8_t)CY_PD_PRT_ROLE_SOURCE)
+    {
+        ptrPdStackContext->ptrAppCbk->psrc_disable(ptrPdStackContext, NULL);
+    }
+#endif /* (!(CY_PD_SINK_ONLY)) */
+#if (!(CY_PD_SOURCE_ONLY))
+    if (ptrPdStackContext->dpmConfig.curPortRole == (uint8_t)CY_PD_PRT_ROLE_SINK)
+    {
+        ptrPdStackContext->ptrAppCbk->psnk_disable(ptrPdStackContext, NULL);
+    }
+#endif /* (!(CY_PD_SOURCE_ONLY)) */
+}
+
+static void fault_dispatched(fault_port_t *ptrFault)
+{
+    if (!ptrFault->dispatched)
+    {
+        ptrFault->dispatched = true;
+        fault_max(&ptrFault->stat.lastDispatchUs, &ptrFault->stat.maxDispatchUs,
+                CY_PDSTACK_GET_TIME_US() - ptrFault->isrStamp);
+    }
+}
+
+static void fault_responded(fault_port_t *ptrFault)
+{
+    fault_max(&ptrFault->stat.lastResponseUs, &ptrFault->stat.maxResponseUs,
+            CY_PDSTACK_GET_TIME_US() - ptrFault->isrStamp);
+    ptrFault->step = FAULT_STEP_DONE;
+}
+
+#if (CY_PD_FAST_FAULT_ALERT_ENABLE)
+static void fault_alert_cbk(cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_resp_status_t resp, const cy_stc_pdstack_pd_packet_t *pkt_ptr)
+{
+    fault_port_t *ptrFault = fault_get(ptrPdStackContext);
+
+    CY_UNUSED_PARAMETER(pkt_ptr);
+
+    if ((ptrFault == NULL) || (resp == CY_PDSTACK_CMD_SENT) || (ptrFault->step != FAULT_STEP_ALERT))
+    {
+        return;
+    }
+
+    /* The hard reset follows whether or not the Alert got through. */
+    ptrFault->step = FAULT_STEP_HARD_RESET;
+    fault_kick(ptrPdStackContext);
+}
+
+static bool fault_send_alert(cy_stc_pdstack_context_t *ptrPdStackContext, fault_port_t *ptrFault)
+{
+    if (ptrPdStackContext->dpmConfig.specRevSopLive < CY_PD_REV3)
+    {
+        return false;
+    }
+
+    ptrFault->cmdBuf.cmdSop        = CY_PD_SOP;
+    ptrFault->cmdBuf.noOfCmdDo     = 1u;
+    ptrFault->cmdBuf.cmdDo[0].val  = (ptrFault->stat.lastType == CY_PDSTACK_FAULT_VBUS_OVP) ?
+        FAULT_ADO_OVP : FAULT_ADO_OCP;
+
+    return (Cy_PdStack_Dpm_SendPdCommand(ptrPdStackContext, CY_PDSTACK_DPM_CMD_SEND_ALERT,
+                &ptrFault->cmdBuf, false, fault_alert_cbk) == CY_PDSTACK_STAT_SUCCESS);
+}
+#endif /* (CY_PD_FAST_FAULT_ALERT_ENABLE) */
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_FaultIsr(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_fault_type_t faultType)
+{
+    fault_port_t *ptrFault = fault_get(ptrPdStackContext);
+    uint32_t intrState;
+    uint32_t now = CY_PDSTACK_GET_TIME_US();
+    bool latch;
+
+    if ((ptrFault == NULL) || (ptrPdStackContext->ptrAppCbk == NULL) ||
+            ((uint8_t)faultType >= (uint8_t)CY_PDSTACK_FAULT_TYPE_COUNT))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    /* The power path first, everything else can wait. */
+    fault_gate(ptrPdStackContext);
+
+    /* Keeps the stack from enabling the power path again when the interrupt
+     * has preempted its task, until Cy_PdStack_Dpm_FaultTask marks the fault
+     * through the DPM API. */
+    ptrPdStackContext->dpmStat.faultActive = true;
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    ptrFault->stat.count[faultType]++;
+    latch = (ptrFault->step == FAULT_STEP_IDLE);
+    if (latch)
+    {
+        ptrFault->isrStamp      = now;
+        ptrFault->dispatched    = false;
+        ptrFault->step          = FAULT_STEP_LATCHED;
+        ptrFault->stat.active   = true;
+        ptrFault->stat.lastType = faultType;
+        fault_max(&ptrFault->stat.lastGateUs, &ptrFault->stat.maxGateUs, CY_PDSTACK_GET_TIME_US() - now);
+    }
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    if (latch)
+    {
+        fault_kick(ptrPdStackContext);
+    }
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_FaultTask(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    fault_port_t *ptrFault = fault_get(ptrPdStackContext);
+
+    if (ptrFault == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    if (ptrFault->step == FAULT_STEP_LATCHED)
+    {
+        (void)Cy_PdStack_Dpm_SetFaultActive(ptrPdStackContext);
+
+        if (!ptrPdStackContext->dpmConfig.attach)
+        {
+            /* Nobody to tell. */
+            ptrFault->step = FAULT_STEP_DONE;
+        }
+        else if (!ptrPdStackContext->dpmConfig.contractExist)
+        {
+            if (Cy_PdStack_Dpm_GoToErrorRecovery(ptrPdStackContext) != CY_PDSTACK_STAT_SUCCESS)
+            {
+                ptrFault->stat.deferCount++;
+                fault_kick(ptrPdStackContext);
+                return CY_PDSTACK_STAT_BUSY;
+            }
+
+            ptrFault->stat.errRecoveryCount++;
+            fault_dispatched(ptrFault);
+            fault_responded(ptrFault);
+        }
+        else
+        {
+            ptrFault->step = FAULT_STEP_HARD_RESET;
+#if (CY_PD_FAST_FAULT_ALERT_ENABLE)
+            if (fault_send_alert(ptrPdStackContext, ptrFault))
+            {
+                ptrFault->stat.alertCount++;
+                ptrFault->step = FAULT_STEP_ALERT;
+                fault_dispatched(ptrFault);
+            }
+#endif /* (CY_PD_FAST_FAULT_ALERT_ENABLE) */
+        }
+    }
+
+    if (ptrFault->step == FAULT_STEP_HARD_RESET)
+    {
+        ptrFault->cmdBuf.cmdSop    = CY_PD_SOP;
+        ptrFault->cmdBuf.noOfCmdDo = 0u;
+        if (Cy_PdStack_Dpm_SendPdCommand(ptrPdStackContext, CY_PDSTACK_DPM_CMD_SEND_HARD_RESET,
+                    &ptrFault->cmdBuf, false, NULL) != CY_PDSTACK_STAT_SUCCESS)
+        {
+            /* Retried right in the next pass. */
+            ptrFault->stat.deferCount++;
+            fault_kick(ptrPdStackContext);
+            return CY_PDSTACK_STAT_BUSY;
+        }
+
+        ptrFault->stat.hardResetCount++;
+        ptrFault->step = FAULT_STEP_WAIT_HR;
+        fault_dispatched(ptrFault);
+    }
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+void Cy_PdStack_Dpm_FaultEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data)
+{
+    fault_port_t *ptrFault = fault_get(ptrPdStackContext);
+
+    CY_UNUSED_PARAMETER(data);
+
+    if ((ptrFault == NULL) || (ptrFault->step == FAULT_STEP_IDLE) || (ptrFault->step == FAULT_STEP_DONE))
+    {
+        return;
+    }
+
+    switch (evt)
+    {
+        case APP_EVT_HARD_RESET_SENT:
+            if (ptrFault->step == FAULT_STEP_WAIT_HR)
+            {
+                fault_responded(ptrFault);
+            }
+            break;
+
+        case APP_EVT_DISCONNECT:
+            /* A pending Alert or hard reset has no partner any more. */
+            if (ptrFault->step != FAULT_STEP_LATCHED)
+            {
+                ptrFault->step = FAULT_STEP_DONE;
+            }
+            break;
+
+        default:
+            /* No effect on the response. */
+            break;
+    }
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_FaultClear(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    fault_port_t *ptrFault = fault_get(ptrPdStackContext);
+    uint32_t intrState;
+
+    if (ptrFault == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    if (ptrFault->step == FAULT_STEP_IDLE)
+    {
+        return CY_PDSTACK_STAT_SUCCESS;
+    }
+
+    if (ptrFault->step != FAULT_STEP_DONE)
+    {
+        return CY_PDSTACK_STAT_BUSY;
+    }
+
+    (void)Cy_PdStack_Dpm_ClearFaultActive(ptrPdStackContext);
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    ptrFault->step        = FAULT_STEP_IDLE;
+    ptrFault->stat.active = false;
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_FaultGetStats(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_fault_stats_t *ptrStats)
+{
+    fault_port_t *ptrFault = fault_get(ptrPdStackContext);
+    uint32_t intrState;
+
+    if ((ptrFault == NULL) || (ptrStats == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    *ptrStats = ptrFault->stat;
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+#endif /* (CY_PD_FAST_FAULT_ENABLE) */
+
+/* [] END OF FILE */
@@ -0,0 +1,207 @@
+/***************************************************************************//**
+* \file cy_pdstack_fault.h
+* \version 4.0
+*
+* Header file of the fast VBus fault response of the PDStack middleware.
+* A fault reported from the detection interrupt gates the power path at once
+* and the protocol response (Alert, Hard Reset or error recovery) is handed to
+* the stack ahead of any other work in the next scheduling pass. The reaction
+* times of each step are recorded.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_FAULT_H)
+#define CY_PDSTACK_FAULT_H
+
+#include "cy_pdstack_common.h"
+
+/**
+* \addtogroup group_pdstack_enums
+* \{
+*/
+
+/**
+ * @typedef cy_en_pdstack_fault_type_t
+ * @brief VBus faults reported through Cy_PdStack_Dpm_FaultIsr.
+ */
+typedef enum
+{
+    CY_PDSTACK_FAULT_VBUS_OVP = 0,              /**< VBus over voltage. */
+    CY_PDSTACK_FAULT_VBUS_OCP,                  /**< VBus over current. */
+    CY_PDSTACK_FAULT_TYPE_COUNT                 /**< Number of fault types. */
+} cy_en_pdstack_fault_type_t;
+
+/** \} group_pdstack_enums */
+
+/**
+* \addtogroup group_pdstack_data_structures
+* \{
+*/
+
+/**
+ * @brief Fault response statistics of a port. All times are measured from the
+ * entry of Cy_PdStack_Dpm_FaultIsr, in us, and stay zero unless
+ * CY_PD_PERF_GET_TIME_US is provided.
+ */
+typedef struct
+{
+    bool                        active;             /**< A fault is latched and not cleared yet. */
+    cy_en_pdstack_fault_type_t  lastType;           /**< Type of the fault latched last. */
+    uint32_t                    count[CY_PDSTACK_FAULT_TYPE_COUNT]; /**< Faults reported per type, reports while
+                                                                         a fault is latched included. */
+    uint32_t                    alertCount;         /**< Alerts handed to the stack. */
+    uint32_t                    hardResetCount;     /**< Hard resets handed to the stack. */
+    uint32_t                    errRecoveryCount;   /**< Error recoveries entered without a contract. */
+    uint32_t                    deferCount;         /**< Task passes in which the stack could not take the response. */
+    uint32_t                    lastGateUs;         /**< Time until the power path was gated, last fault. */
+    uint32_t                    maxGateUs;          /**< Largest time until the power path was gated. */
+    uint32_t                    lastDispatchUs;     /**< Time until the first response was handed to the stack,
+                                                         last fault. */
+    uint32_t                    maxDispatchUs;      /**< Largest time until the first response was handed to the
+                                                         stack. */
+    uint32_t                    lastResponseUs;     /**< Time until the hard reset was sent or error recovery was
+                                                         entered, last fault. */
+    uint32_t                    maxResponseUs;      /**< Largest time until the hard reset was sent or error
+                                                         recovery was entered. */
+} cy_stc_pdstack_fault_stats_t;
+
+/** \} group_pdstack_data_structures */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_FaultIsr
+****************************************************************************//**
+*
+* Reports a VBus fault of a port. Safe to be called from the interrupt which
+* detects the fault. The power path of the current power role is gated right
+* away through the psrc_disable or psnk_disable application callback, which
+* must therefore be callable from this interrupt. The fault is latched and the
+* protocol response is posted as CY_PDSTACK_PEND_FAULT, which
+* Cy_PdStack_Dpm_TaskAll serves in the highest urgency class and before the
+* stack task of the port.
+*
+* Without the event-driven scheduler, Cy_PdStack_Dpm_FaultTask must be called
+* from the main loop, right before Cy_PdStack_Dpm_Task of the port.
+*
+* Reports while a fault is latched gate the power path again and are counted,
+* but do not start another response.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param faultType
+* Fault detected.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_FaultIsr(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_fault_type_t faultType);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_FaultTask
+****************************************************************************//**
+*
+* Hands the response to a latched fault to the stack: the fault is marked
+* active, then the hard reset is sent if a contract exists, or error recovery
+* is entered otherwise. With CY_PD_FAST_FAULT_ALERT_ENABLE, a PD 3.x port
+* sends an Alert carrying the fault type first, and the hard reset follows
+* once the Alert is done. A response which the stack cannot take yet is
+* retried on the next pass.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BUSY if the response could not be handed to the stack yet.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_FaultTask(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_FaultEventHandler
+****************************************************************************//**
+*
+* Records the time at which the hard reset has been sent, and ends a pending
+* response when the port is detached. To be called from the application event
+* handler.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param evt
+* Event ID.
+*
+* \param data
+* Event data.
+*
+* \return
+* None
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_FaultEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_FaultClear
+****************************************************************************//**
+*
+* Clears the latched fault of a port once the fault condition is gone, so
+* that the stack can restore the power path. The statistics are kept.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BUSY if the response to the fault is still in progress.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_FaultClear(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_FaultGetStats
+****************************************************************************//**
+*
+* Reports the fault response statistics of a port.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrStats
+* Output parameter which receives the statistics.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_FaultGetStats(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_fault_stats_t *ptrStats);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_FAULT_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,214 @@
+/***************************************************************************//**
+* \file cy_pdstack_frs.c
+* \version 4.0
+*
+* Source file of the Fast Role Swap fast path of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include "cy_syslib.h"
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_frs.h"
+#include "cy_pdstack_perf.h"
+#if (CY_PD_EVENT_DRIVEN_TASK_ENABLE)
+#include "cy_pdstack_sched.h"
+#endif /* (CY_PD_EVENT_DRIVEN_TASK_ENABLE) */
+
+#if ((CY_PD_FRS_FAST_PATH_ENABLE) && (CY_PDSTACK_CFG_FRS_SUPP) && \
+     (!(CY_PD_SOURCE_ONLY)) && (!(CY_PD_SINK_ONLY)))
+
+typedef struct
+{
+    cy_stc_pdstack_frs_status_t     stat;
+    cy_pdstack_frs_pwr_cbk_t        pwrPathEnable;
+    uint32_t                        signalStamp;
+    app_resp_t                      resp;
+} frs_port_t;
+
+static frs_port_t gl_frs[CY_PD_MAX_NO_OF_PORTS];
+
+static frs_port_t *frs_get(const cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    if ((ptrPdStackContext == NULL) || (ptrPdStackContext->port >= CY_PD_MAX_NO_OF_PORTS))
+    {
+        return NULL;
+    }
+
+    return &gl_frs[ptrPdStackContext->port];
+}
+
+/* Drops the approval and the power path action together, as the interrupt
+ * reads them together. */
+static void frs_disarm(frs_port_t *ptrFrs)
+{
+    uint32_t intrState;
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    ptrFrs->stat.armed    = false;
+    ptrFrs->pwrPathEnable = NULL;
+    Cy_SysLib_ExitCriticalSection(intrState);
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_FrsArm(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_pdstack_frs_pwr_cbk_t pwrPathEnable)
+{
+    frs_port_t *ptrFrs = frs_get(ptrPdStackContext);
+    uint32_t intrState;
+
+    if (ptrFrs == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    /* The callback and the flag are read together by the interrupt. */
+    intrState = Cy_SysLib_EnterCriticalSection();
+    ptrFrs->pwrPathEnable = pwrPathEnable;
+    ptrFrs->stat.armed    = true;
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_FrsDisarm(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    frs_port_t *ptrFrs = frs_get(ptrPdStackContext);
+
+    if (ptrFrs == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    frs_disarm(ptrFrs);
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+void Cy_PdStack_Dpm_FrsSignalIsr(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    frs_port_t *ptrFrs = frs_get(ptrPdStackContext);
+    uint32_t pwrUs;
+
+    /* The signal and the VBus drop can both be reported for one swap. */
+    if ((ptrFrs == NULL) || (!ptrFrs->stat.armed) || (ptrFrs->stat.inProgress))
+    {
+        return;
+    }
+
+    ptrFrs->signalStamp = CY_PDSTACK_GET_TIME_US();
+    if (ptrFrs->pwrPathEnable != NULL)
+    {
+        ptrFrs->pwrPathEnable(ptrPdStackContext);
+    }
+    pwrUs = CY_PDSTACK_GET_TIME_US() - ptrFrs->signalStamp;
+
+    ptrFrs->stat.inProgress = true;
+    ptrFrs->stat.signalCount++;
+    ptrFrs->stat.lastPwrUs = pwrUs;
+    if (pwrUs > ptrFrs->stat.maxPwrUs)
+    {
+        ptrFrs->stat.maxPwrUs = pwrUs;
+    }
+
+#if (CY_PD_EVENT_DRIVEN_TASK_ENABLE)
+    (void)Cy_PdStack_Dpm_SetPendingWork(ptrPdStackContext, CY_PDSTACK_PEND_PE_EVT);
+#endif /* (CY_PD_EVENT_DRIVEN_TASK_ENABLE) */
+}
+
+void Cy_PdStack_Dpm_FrsEvalFrSwap(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_pdstack_app_resp_cbk_t app_resp_handler)
+{
+    frs_port_t *ptrFrs = frs_get(ptrPdStackContext);
+
+    if ((ptrFrs == NULL) || (app_resp_handler == NULL))
+    {
+        return;
+    }
+
+    /* The response is kept in the port state, the stack may read it after
+     * the handler returns. */
+    ptrFrs->resp.respDo.val = 0u;
+    ptrFrs->resp.reqStatus  = (ptrFrs->stat.armed) ? CY_PDSTACK_REQ_ACCEPT : CY_PDSTACK_REQ_REJECT;
+    app_resp_handler(ptrPdStackContext, &ptrFrs->resp);
+}
+
+void Cy_PdStack_Dpm_FrsEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data)
+{
+    frs_port_t *ptrFrs = frs_get(ptrPdStackContext);
+    uint32_t swapUs;
+
+    CY_UNUSED_PARAMETER(data);
+
+    if (ptrFrs == NULL)
+    {
+        return;
+    }
+
+    switch (evt)
+    {
+        case APP_EVT_FR_SWAP_COMPLETE:
+            if (ptrFrs->stat.inProgress)
+            {
+                swapUs = CY_PDSTACK_GET_TIME_US() - ptrFrs->signalStamp;
+                ptrFrs->stat.lastSwapUs = swapUs;
+                if (swapUs > ptrFrs->stat.maxSwapUs)
+                {
+                    ptrFrs->stat.maxSwapUs = swapUs;
+                }
+            }
+            ptrFrs->stat.swapCount++;
+            ptrFrs->stat.inProgress = false;
+
+            /* A new approval is needed for the next contract. */
+            frs_disarm(ptrFrs);
+            break;
+
+        case APP_EVT_DISCONNECT:
+        case APP_EVT_HARD_RESET_RCVD:
+        case APP_EVT_HARD_RESET_SENT:
+        case APP_EVT_TYPE_C_ERROR_RECOVERY:
+            /* The approval belongs to the contract which has just ended. */
+            ptrFrs->stat.inProgress = false;
+            frs_disarm(ptrFrs);
+            break;
+
+        default:
+            /* Not related to the swap. */
+            break;
+    }
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_FrsGetStatus(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_frs_status_t *ptrStatus)
+{
+    frs_port_t *ptrFrs = frs_get(ptrPdStackContext);
+    uint32_t intrState;
+
+    if ((ptrFrs == NULL) || (ptrStatus == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    *ptrStatus = ptrFrs->stat;
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+#endif /* ((CY_PD_FRS_FAST_PATH_ENABLE) && (CY_PDSTACK_CFG_FRS_SUPP) && (!(CY_PD_SOURCE_ONLY)) && (!(CY_PD_SINK_ONLY))) */
+
+/* [] END OF FILE */
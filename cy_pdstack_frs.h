@@ -0,0 +1,189 @@
+/***************************************************************************//**
+* \file cy_pdstack_frs.h
+* \version 4.0
+*
+* Header file of the Fast Role Swap fast path of the PDStack middleware. The
+* application approves the swap and provides the power path action in
+* advance, so that the time-critical part runs in interrupt context and the
+* FR_Swap request is answered without waiting for application code.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_FRS_H)
+#define CY_PDSTACK_FRS_H
+
+#include "cy_pdstack_common.h"
+
+/**
+* \addtogroup group_pdstack_data_structures
+* \{
+*/
+
+/**
+ * @brief Power path action run from interrupt context when the FR_Swap signal
+ * is detected, for example enabling the provider FET of the new source.
+ */
+typedef void (*cy_pdstack_frs_pwr_cbk_t)(cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/**
+ * @brief Status of the FRS fast path of a port. Times are in us, measured with
+ * the CY_PD_PERF_GET_TIME_US time base, and are zero when it is not set.
+ */
+typedef struct
+{
+    bool        armed;              /**< The swap is pre-approved. */
+    bool        inProgress;         /**< FR_Swap signal seen, swap not completed yet. */
+    uint16_t    signalCount;        /**< Number of FR_Swap signals handled while armed. */
+    uint16_t    swapCount;          /**< Number of completed swaps. */
+    uint32_t    lastPwrUs;          /**< Time taken by the power path action of the last swap. */
+    uint32_t    maxPwrUs;           /**< Longest power path action. */
+    uint32_t    lastSwapUs;         /**< FR_Swap signal to APP_EVT_FR_SWAP_COMPLETE of the last swap. */
+    uint32_t    maxSwapUs;          /**< Longest FR_Swap signal to completion time. */
+} cy_stc_pdstack_frs_status_t;
+
+/** \} group_pdstack_data_structures */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_FrsArm
+****************************************************************************//**
+*
+* Pre-approves the next Fast Role Swap of the port. FRS receive must be
+* enabled separately, through the port configuration or
+* Cy_PdStack_Dpm_UpdateFrsEnable. The approval is consumed by the swap and has
+* to be renewed for the next one.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param pwrPathEnable
+* Power path action run by Cy_PdStack_Dpm_FrsSignalIsr. Can be NULL when the
+* hardware switches the power path by itself.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_FrsArm(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_pdstack_frs_pwr_cbk_t pwrPathEnable);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_FrsDisarm
+****************************************************************************//**
+*
+* Withdraws the approval given with Cy_PdStack_Dpm_FrsArm and forgets the
+* power path action. FR_Swap requests are rejected until the port is armed
+* again.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_FrsDisarm(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_FrsSignalIsr
+****************************************************************************//**
+*
+* Time-critical part of the swap. To be called from the interrupt in which the
+* FR_Swap signal or the loss of VBus is detected. On an armed port, the power
+* path action is run, the time stamps are taken and, when
+* CY_PD_EVENT_DRIVEN_TASK_ENABLE is set, policy engine work is posted so that
+* the stack handles the FR_Swap message on the next task pass. Nothing is done
+* on a port which is not armed.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_FrsSignalIsr(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_FrsEvalFrSwap
+****************************************************************************//**
+*
+* Implementation of the eval_fr_swap application callback. Accepts the
+* FR_Swap request if the port is armed and rejects it otherwise, in the context
+* of the stack. Can be placed directly in the cy_stc_pdstack_app_cbk_t
+* structure.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param app_resp_handler
+* Callback through which the response is reported.
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_FrsEvalFrSwap(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_pdstack_app_resp_cbk_t app_resp_handler);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_FrsEventHandler
+****************************************************************************//**
+*
+* Completes the swap bookkeeping: the swap time is recorded and the approval
+* consumed on APP_EVT_FR_SWAP_COMPLETE. On disconnect, hard reset or error
+* recovery, a swap in progress is dropped and the port is disarmed as by
+* Cy_PdStack_Dpm_FrsDisarm, so that it must be armed again for the next
+* contract. To be called from the application event handler.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param evt
+* Event ID.
+*
+* \param data
+* Event data.
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_FrsEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_FrsGetStatus
+****************************************************************************//**
+*
+* Reports the state and the measured timing of the FRS fast path.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrStatus
+* Output parameter which receives the status.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_FrsGetStatus(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_frs_status_t *ptrStatus);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_FRS_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,52 @@
+/***************************************************************************//**
+* \file cy_pdstack_mem.c
+* \version 4.0
+*
+* Source file of the memory usage reporting support of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_mem.h"
+
+#if (CY_PD_CONTEXT_SIZE_BUDGET != 0u)
+/* Fails to compile when the context grows beyond the configured budget. */
+typedef char cy_pdstack_context_size_check_t[(sizeof(cy_stc_pdstack_context_t) <= CY_PD_CONTEXT_SIZE_BUDGET) ? 1 : -1];
+#endif /* (CY_PD_CONTEXT_SIZE_BUDGET != 0u) */
+
+#define MEM_MEMBER_SIZE(type, member)   ((uint16_t)sizeof(((type *)NULL)->member))
+
+cy_en_pdstack_status_t Cy_PdStack_Mem_GetFootprint(
+        cy_stc_pdstack_mem_footprint_t *ptrFootprint)
+{
+    if (ptrFootprint == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    ptrFootprint->contextSize    = (uint16_t)sizeof(cy_stc_pdstack_context_t);
+    ptrFootprint->dpmStatSize    = MEM_MEMBER_SIZE(cy_stc_pdstack_context_t, dpmStat);
+    ptrFootprint->dpmExtStatSize = MEM_MEMBER_SIZE(cy_stc_pdstack_context_t, dpmExtStat);
+    ptrFootprint->pdStatSize     = MEM_MEMBER_SIZE(cy_stc_pdstack_context_t, pdStat);
+    ptrFootprint->peStatSize     = MEM_MEMBER_SIZE(cy_stc_pdstack_context_t, peStat);
+    ptrFootprint->typecStatSize  = MEM_MEMBER_SIZE(cy_stc_pdstack_context_t, typecStat);
+    ptrFootprint->amsScratchSize = (uint16_t)(
+            MEM_MEMBER_SIZE(cy_stc_pdstack_pe_status_t, rcvdPkt) +
+            MEM_MEMBER_SIZE(cy_stc_pdstack_pe_status_t, vdmPkt) +
+            MEM_MEMBER_SIZE(cy_stc_pdstack_pe_status_t, dpmResp) +
+            MEM_MEMBER_SIZE(cy_stc_pdstack_pe_status_t, vsBuf) +
+            MEM_MEMBER_SIZE(cy_stc_pdstack_pe_status_t, cblBuf) +
+            MEM_MEMBER_SIZE(cy_stc_pdstack_pe_status_t, peCmdBuf) +
+            MEM_MEMBER_SIZE(cy_stc_pdstack_pe_status_t, eprSnkExtdChunkBuffer));
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,78 @@
+/***************************************************************************//**
+* \file cy_pdstack_mem.h
+* \version 4.0
+*
+* Header file of the memory usage reporting support of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_MEM_H)
+#define CY_PDSTACK_MEM_H
+
+#include "cy_pdstack_common.h"
+
+/*******************************************************************************
+*                              Type definitions
+*******************************************************************************/
+
+/**
+* \addtogroup group_pdstack_data_structures
+* \{
+*/
+
+/**
+ * @brief Per-port RAM footprint of the PDStack context, in bytes, as seen by
+ * the build that includes this file. The layout of cy_stc_pdstack_context_t is
+ * shared by all library variants and is fixed by the pre-compiled libraries.
+ */
+typedef struct
+{
+    uint16_t contextSize;       /**< sizeof(cy_stc_pdstack_context_t). */
+    uint16_t dpmStatSize;       /**< Device policy manager status (dpmStat). */
+    uint16_t dpmExtStatSize;    /**< PD 3.1 device policy manager status (dpmExtStat). */
+    uint16_t pdStatSize;        /**< Protocol layer status (pdStat). */
+    uint16_t peStatSize;        /**< Policy engine status (peStat). */
+    uint16_t typecStatSize;     /**< Type-C manager status (typecStat). */
+    uint16_t amsScratchSize;    /**< Part of peStat only used while an AMS is in progress:
+                                     received packet, VDM and DPM response packets,
+                                     VConn swap, cable and policy engine command buffers
+                                     and the EPR chunk buffer. */
+} cy_stc_pdstack_mem_footprint_t;
+
+/** \} group_pdstack_data_structures */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Mem_GetFootprint
+****************************************************************************//**
+*
+* Reports the RAM taken by one PDStack context and its main parts. Together with
+* CY_PD_CONTEXT_SIZE_BUDGET, this can be used to track the per-port memory
+* budget of a design.
+*
+* \param ptrFootprint
+* Output parameter which receives the footprint information.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Mem_GetFootprint(
+        cy_stc_pdstack_mem_footprint_t *ptrFootprint);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_MEM_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,241 @@
+/***************************************************************************//**
+* \file cy_pdstack_perf.c
+* \version 4.0
+*
+* Source file of the latency instrumentation of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "cy_syslib.h"
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_perf.h"
+
+#if (CY_PD_PERF_STATS_ENABLE)
+
+/* End-to-end measurements in progress, see Cy_PdStack_Perf_Event. */
+#define PERF_ARM_CONTRACT               (0x01u)
+#define PERF_ARM_EPR                    (0x02u)
+#define PERF_ARM_CABLE                  (0x04u)
+
+typedef struct
+{
+    uint32_t    contractStamp;
+    uint32_t    eprStamp;
+    uint32_t    cableStamp;
+    uint8_t     armed;
+} perf_mark_t;
+
+static cy_stc_pdstack_perf_stats_t gl_perfStats[CY_PD_MAX_NO_OF_PORTS];
+static perf_mark_t gl_perfMark[CY_PD_MAX_NO_OF_PORTS];
+
+static cy_stc_pdstack_perf_stats_t *perf_get(const cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    if ((ptrPdStackContext == NULL) || (ptrPdStackContext->port >= CY_PD_MAX_NO_OF_PORTS))
+    {
+        return NULL;
+    }
+
+    return &gl_perfStats[ptrPdStackContext->port];
+}
+
+void Cy_PdStack_Perf_Record(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_perf_id_t id,
+        uint32_t durationUs)
+{
+    cy_stc_pdstack_perf_stats_t *ptrStats = perf_get(ptrPdStackContext);
+    cy_stc_pdstack_perf_stat_t *ptrStat;
+    uint32_t intState;
+    uint32_t limit = CY_PD_PERF_HIST_BASE_US;
+    uint8_t bin = 0u;
+
+    if ((ptrStats == NULL) || ((uint32_t)id >= (uint32_t)CY_PDSTACK_PERF_ID_COUNT))
+    {
+        return;
+    }
+
+    while ((bin < (CY_PDSTACK_PERF_HIST_BINS - 1u)) && (durationUs >= limit))
+    {
+        limit <<= 1u;
+        bin++;
+    }
+
+    ptrStat  = &ptrStats->stat[id];
+    intState = Cy_SysLib_EnterCriticalSection();
+    if ((ptrStat->count == 0u) || (durationUs < ptrStat->minUs))
+    {
+        ptrStat->minUs = durationUs;
+    }
+    if (durationUs > ptrStat->maxUs)
+    {
+        ptrStat->maxUs = durationUs;
+    }
+    ptrStat->lastUs = durationUs;
+    ptrStat->count++;
+    if (ptrStat->hist[bin] != 0xFFFFu)
+    {
+        ptrStat->hist[bin]++;
+    }
+    Cy_SysLib_ExitCriticalSection(intState);
+}
+
+void Cy_PdStack_Perf_Event(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data)
+{
+    perf_mark_t *ptrMark;
+    uint32_t now;
+    bool success;
+
+    if (perf_get(ptrPdStackContext) == NULL)
+    {
+        return;
+    }
+
+    ptrMark = &gl_perfMark[ptrPdStackContext->port];
+    now     = CY_PD_PERF_GET_TIME_US();
+
+    switch (evt)
+    {
+        case APP_EVT_TYPEC_ATTACH:
+            ptrMark->contractStamp = now;
+            ptrMark->cableStamp    = now;
+            ptrMark->armed         = (PERF_ARM_CONTRACT | PERF_ARM_CABLE);
+            break;
+
+        case APP_EVT_HARD_RESET_COMPLETE:
+            ptrMark->contractStamp = now;
+            ptrMark->armed        |= PERF_ARM_CONTRACT;
+            ptrMark->armed        &= (uint8_t)~PERF_ARM_EPR;
+            break;
+
+        case APP_EVT_DISCONNECT:
+        case APP_EVT_TYPE_C_ERROR_RECOVERY:
+            ptrMark->armed = 0u;
+            break;
+
+        case APP_EVT_PD_CONTRACT_NEGOTIATION_COMPLETE:
+            success = ((data != NULL) &&
+                    (((const cy_stc_pdstack_pd_contract_info_t *)data)->status ==
+                     CY_PDSTACK_CONTRACT_NEGOTIATION_SUCCESSFUL));
+            if (!success)
+            {
+                break;
+            }
+
+            if ((ptrMark->armed & PERF_ARM_CONTRACT) != 0u)
+            {
+                Cy_PdStack_Perf_Record(ptrPdStackContext, CY_PDSTACK_PERF_CONTRACT, now - ptrMark->contractStamp);
+                ptrMark->armed &= (uint8_t)~PERF_ARM_CONTRACT;
+            }
+
+            /* A sink has no entry success event: its EPR entry ends with the
+             * first EPR contract and is timed from the SPR contract. */
+            if (ptrPdStackContext->dpmConfig.curPortRole == (uint8_t)CY_PD_PRT_ROLE_SINK)
+            {
+                if (CY_PDSTACK_CFG_EPR_ACTIVE(ptrPdStackContext))
+                {
+                    if ((ptrMark->armed & PERF_ARM_EPR) != 0u)
+                    {
+                        Cy_PdStack_Perf_Record(ptrPdStackContext, CY_PDSTACK_PERF_EPR_ENTRY,
+                                now - ptrMark->eprStamp);
+                        ptrMark->armed &= (uint8_t)~PERF_ARM_EPR;
+                    }
+                }
+                else if (CY_PDSTACK_CFG_EPR_SNK_EN(ptrPdStackContext))
+                {
+                    ptrMark->eprStamp = now;
+                    ptrMark->armed   |= PERF_ARM_EPR;
+                }
+                else
+                {
+                    /* EPR is not used by this sink. */
+                }
+            }
+            break;
+
+        case APP_EVT_EPR_MODE_ENTER_RECEIVED:
+            ptrMark->eprStamp = now;
+            ptrMark->armed   |= PERF_ARM_EPR;
+            break;
+
+        case APP_EVT_EPR_MODE_ENTER_SUCCESS:
+            if ((ptrMark->armed & PERF_ARM_EPR) != 0u)
+            {
+                Cy_PdStack_Perf_Record(ptrPdStackContext, CY_PDSTACK_PERF_EPR_ENTRY, now - ptrMark->eprStamp);
+                ptrMark->armed &= (uint8_t)~PERF_ARM_EPR;
+            }
+            break;
+
+        case APP_EVT_EPR_MODE_ENTER_FAILED:
+        case APP_EVT_EPR_MODE_EXIT:
+            ptrMark->armed &= (uint8_t)~PERF_ARM_EPR;
+            break;
+
+        case APP_EVT_EMCA_DETECTED:
+            if ((ptrMark->armed & PERF_ARM_CABLE) != 0u)
+            {
+                Cy_PdStack_Perf_Record(ptrPdStackContext, CY_PDSTACK_PERF_CABLE_DISC, now - ptrMark->cableStamp);
+            }
+            ptrMark->armed &= (uint8_t)~PERF_ARM_CABLE;
+            break;
+
+        case APP_EVT_EMCA_NOT_DETECTED:
+            ptrMark->armed &= (uint8_t)~PERF_ARM_CABLE;
+            break;
+
+        default:
+            /* Not part of a measurement. */
+            break;
+    }
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_GetPerfStats(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_perf_stats_t *ptrStats)
+{
+    cy_stc_pdstack_perf_stats_t *ptrPort = perf_get(ptrPdStackContext);
+    uint32_t intState;
+
+    if ((ptrPort == NULL) || (ptrStats == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intState = Cy_SysLib_EnterCriticalSection();
+    (void)memcpy(ptrStats, ptrPort, sizeof(cy_stc_pdstack_perf_stats_t));
+    Cy_SysLib_ExitCriticalSection(intState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_ClearPerfStats(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    cy_stc_pdstack_perf_stats_t *ptrPort = perf_get(ptrPdStackContext);
+    uint32_t intState;
+
+    if (ptrPort == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intState = Cy_SysLib_EnterCriticalSection();
+    (void)memset(ptrPort, 0, sizeof(cy_stc_pdstack_perf_stats_t));
+    Cy_SysLib_ExitCriticalSection(intState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+#endif /* (CY_PD_PERF_STATS_ENABLE) */
+
+/* [] END OF FILE */
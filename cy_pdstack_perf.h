@@ -0,0 +1,252 @@
+/***************************************************************************//**
+* \file cy_pdstack_perf.h
+* \version 4.0
+*
+* Header file of the latency instrumentation of the PDStack middleware.
+* When CY_PD_PERF_STATS_ENABLE is zero, all instrumentation macros expand to
+* nothing and no code or data is added to the build.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_PERF_H)
+#define CY_PDSTACK_PERF_H
+
+#include "cy_pdstack_common.h"
+
+#if ((CY_PD_PERF_STATS_ENABLE) && !defined(CY_PD_PERF_GET_TIME_US))
+#error "CY_PD_PERF_GET_TIME_US() must provide a free-running 32-bit microsecond count."
+#endif
+
+/*******************************************************************************
+*                              Type definitions
+*******************************************************************************/
+
+/**
+* \addtogroup group_pdstack_macros
+* \{
+*/
+
+/** Free-running 32-bit microsecond count used by all time stamps of the
+ * middleware: the latency statistics, the trace and the timing statistics of
+ * the optional modules. Reads CY_PD_PERF_GET_TIME_US when the application
+ * provides it, and zero otherwise. */
+#if defined(CY_PD_PERF_GET_TIME_US)
+#define CY_PDSTACK_GET_TIME_US()                ((uint32_t)CY_PD_PERF_GET_TIME_US())
+#else
+#define CY_PDSTACK_GET_TIME_US()                (0u)
+#endif /* defined(CY_PD_PERF_GET_TIME_US) */
+
+/** Number of histogram bins of each latency statistic. */
+#define CY_PDSTACK_PERF_HIST_BINS               (8u)
+
+#if (CY_PD_PERF_STATS_ENABLE)
+
+/** Declares a timestamp variable used with the other CY_PDSTACK_PERF macros. */
+#define CY_PDSTACK_PERF_DECLARE(ts)             uint32_t ts = 0u
+
+/** Captures the start time of a measurement. */
+#define CY_PDSTACK_PERF_START(ts)               ((ts) = CY_PD_PERF_GET_TIME_US())
+
+/** Records the time elapsed since CY_PDSTACK_PERF_START under a statistic. */
+#define CY_PDSTACK_PERF_END(context, id, ts)    \
+    Cy_PdStack_Perf_Record((context), (id), (uint32_t)(CY_PD_PERF_GET_TIME_US() - (ts)))
+
+#else
+
+/** Declares a timestamp variable used with the other CY_PDSTACK_PERF macros. */
+#define CY_PDSTACK_PERF_DECLARE(ts)
+
+/** Captures the start time of a measurement. */
+#define CY_PDSTACK_PERF_START(ts)
+
+/** Records the time elapsed since CY_PDSTACK_PERF_START under a statistic. */
+#define CY_PDSTACK_PERF_END(context, id, ts)
+
+#endif /* (CY_PD_PERF_STATS_ENABLE) */
+
+/** \} group_pdstack_macros */
+
+/**
+* \addtogroup group_pdstack_enums
+* \{
+*/
+
+/**
+ * @typedef cy_en_pdstack_perf_id_t
+ * @brief Latency statistics maintained per port.
+ */
+typedef enum
+{
+    CY_PDSTACK_PERF_INTR_TO_TASK = 0,
+    /**< 0x00: Work posted through Cy_PdStack_Dpm_SetPendingWork to start of handling. */
+
+    CY_PDSTACK_PERF_TIMER_TO_TASK,
+    /**< 0x01: Timer expiry (CY_PDSTACK_PEND_TIMER posted) to start of handling. */
+
+    CY_PDSTACK_PERF_TASK_RUN,
+    /**< 0x02: Duration of Cy_PdStack_Dpm_Task. */
+
+    CY_PDSTACK_PERF_CMD_TO_SENT,
+    /**< 0x03: Queued command handed to the stack to GoodCRC (CY_PDSTACK_CMD_SENT). */
+
+    CY_PDSTACK_PERF_CMD_TO_RESP,
+    /**< 0x04: Queued command handed to the stack to response from the port partner. */
+
+    CY_PDSTACK_PERF_APP_EVT_CBK,
+    /**< 0x05: Duration of the app_event_handler callback. */
+
+    CY_PDSTACK_PERF_EVAL_SRC_CAP_CBK,
+    /**< 0x06: Duration of the eval_src_cap callback. */
+
+    CY_PDSTACK_PERF_EVAL_RDO_CBK,
+    /**< 0x07: Duration of the eval_rdo callback. */
+
+    CY_PDSTACK_PERF_USER,
+    /**< 0x08: Application-defined latency, e.g. Accept to PS_RDY. */
+
+    CY_PDSTACK_PERF_CONTRACT,
+    /**< 0x09: Type-C attach or hard reset completion to successful contract negotiation.
+         Recorded by Cy_PdStack_Perf_Event. */
+
+    CY_PDSTACK_PERF_EPR_ENTRY,
+    /**< 0x0A: EPR mode entry. Source: EPR_Mode Enter received to entry success. Sink:
+         SPR contract to the first EPR contract. Recorded by Cy_PdStack_Perf_Event. */
+
+    CY_PDSTACK_PERF_CABLE_DISC,
+    /**< 0x0B: Type-C attach to successful cable (EMCA) discovery. Recorded by
+         Cy_PdStack_Perf_Event. */
+
+    CY_PDSTACK_PERF_ID_COUNT
+    /**< 0x0C: Number of statistics. */
+} cy_en_pdstack_perf_id_t;
+
+/** \} group_pdstack_enums */
+
+/**
+* \addtogroup group_pdstack_data_structures
+* \{
+*/
+
+/**
+ * @brief Latency statistic. Bin n of the histogram counts samples below
+ * CY_PD_PERF_HIST_BASE_US * 2^n; the last bin counts all longer samples.
+ */
+typedef struct
+{
+    uint32_t count;                             /**< Number of samples. */
+    uint32_t minUs;                             /**< Shortest sample in us. */
+    uint32_t maxUs;                             /**< Longest sample in us. */
+    uint32_t lastUs;                            /**< Most recent sample in us. */
+    uint16_t hist[CY_PDSTACK_PERF_HIST_BINS];   /**< Sample histogram, saturating. */
+} cy_stc_pdstack_perf_stat_t;
+
+/**
+ * @brief Latency statistics of a port.
+ */
+typedef struct
+{
+    cy_stc_pdstack_perf_stat_t stat[CY_PDSTACK_PERF_ID_COUNT];  /**< Statistics indexed by cy_en_pdstack_perf_id_t. */
+} cy_stc_pdstack_perf_stats_t;
+
+/** \} group_pdstack_data_structures */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Perf_Record
+****************************************************************************//**
+*
+* Adds a latency sample to a statistic of the port. Normally used through the
+* CY_PDSTACK_PERF_END macro; the application measures its callbacks this way.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param id
+* Statistic to be updated.
+*
+* \param durationUs
+* Sample value in us.
+*
+*******************************************************************************/
+void Cy_PdStack_Perf_Record(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_perf_id_t id,
+        uint32_t durationUs);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Perf_Event
+****************************************************************************//**
+*
+* Records the end-to-end statistics CY_PDSTACK_PERF_CONTRACT,
+* CY_PDSTACK_PERF_EPR_ENTRY and CY_PDSTACK_PERF_CABLE_DISC from the application
+* events of the port. Intended to be called at the top of the application
+* event handler.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param evt
+* Event ID.
+*
+* \param data
+* Event data.
+*
+*******************************************************************************/
+void Cy_PdStack_Perf_Event(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_GetPerfStats
+****************************************************************************//**
+*
+* Copies the latency statistics of the port.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrStats
+* Output parameter which receives the statistics.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_GetPerfStats(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_perf_stats_t *ptrStats);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_ClearPerfStats
+****************************************************************************//**
+*
+* Clears the latency statistics of the port.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_ClearPerfStats(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_PERF_H */
+
+/* [] END OF FILE */
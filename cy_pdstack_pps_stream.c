@@ -0,0 +1,542 @@
+/***************************************************************************//**
+* \file cy_pdstack_pps_stream.c
+* \version 4.0
+*
+* Source file of the PPS/AVS streaming request mode of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include "cy_syslib.h"
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_dpm.h"
+#include "cy_pdstack_pps_stream.h"
+#if (CY_PD_EVENT_DRIVEN_TASK_ENABLE)
+#include "cy_pdstack_sched.h"
+#endif /* (CY_PD_EVENT_DRIVEN_TASK_ENABLE) */
+#if (CY_PD_TRACE_ENABLE)
+#include "cy_pdstack_trace.h"
+#endif /* (CY_PD_TRACE_ENABLE) */
+
+#if ((CY_PD_PPS_STREAM_ENABLE) && (CY_PDSTACK_CFG_SNK_SUPP) && (CY_PDSTACK_CFG_PPS_SUPP))
+
+/* Extracts a bit field from a data object. */
+#define STREAM_FIELD(val, pos, mask)    (((val) >> (pos)) & (mask))
+
+/* APDO type (B31:30) and subtype (B29:28). */
+#define STREAM_PDO_APDO                 (3u)
+#define STREAM_APDO_PPS                 (0u)
+#define STREAM_APDO_EPR_AVS             (1u)
+
+/* Control message codes of the responses to a request. */
+#define STREAM_MSG_ACCEPT               (3u)
+#define STREAM_MSG_REJECT               (4u)
+#define STREAM_MSG_WAIT                 (12u)
+
+/* RDO flag fields. */
+#define STREAM_RDO_POS_POS              (28u)
+#define STREAM_RDO_USB_COMM             (1UL << 25u)
+#define STREAM_RDO_NO_USB_SUSP          (1UL << 24u)
+#define STREAM_RDO_EPR_CAPABLE          (1UL << 22u)
+
+/* Request resolution: 20 mV (PPS), 100 mV (EPR AVS) and 50 mA. */
+#define STREAM_PPS_VOLT_STEP            (20u)
+#define STREAM_AVS_VOLT_STEP            (100u)
+#define STREAM_CUR_STEP                 (5u)
+
+#define STREAM_TIMER_ID(ptrPdStackContext)                                      \
+    ((cy_timer_id_t)(CY_PDSTACK_PPS_STREAM_TIMER_BASE_ID + (ptrPdStackContext)->port))
+
+typedef struct
+{
+    cy_stc_pdstack_pps_stream_status_t  stat;
+
+    /* Decoded APDO limits. For EPR AVS, maxCur is recomputed from the PDP for
+     * every setpoint. */
+    uint32_t                            pdo;
+    uint16_t                            minVolt;
+    uint16_t                            maxVolt;
+    uint16_t                            maxCur;
+    uint8_t                             pdp;
+    bool                                avs;
+
+    /* Mailbox written by Cy_PdStack_Dpm_PpsStreamSetTarget. */
+    volatile uint16_t                   mboxVolt;
+    volatile uint16_t                   mboxCur;
+    volatile uint8_t                    mboxSeq;
+    uint8_t                             doneSeq;
+
+    /* Resend the last setpoint once the hold-off has expired. */
+    bool                                retry;
+    volatile bool                       holdOff;
+
+    /* In use by the stack until stream_cmd_cbk; a new setpoint waits in the
+     * mailbox meanwhile. */
+    cy_stc_pdstack_dpm_pd_cmd_buf_t     cmdBuf;
+} stream_port_t;
+
+static stream_port_t gl_ppsStream[CY_PD_MAX_NO_OF_PORTS];
+
+static stream_port_t *stream_get(const cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    if ((ptrPdStackContext == NULL) || (ptrPdStackContext->port >= CY_PD_MAX_NO_OF_PORTS))
+    {
+        return NULL;
+    }
+
+    return &gl_ppsStream[ptrPdStackContext->port];
+}
+
+static void stream_kick(cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+#if (CY_PD_EVENT_DRIVEN_TASK_ENABLE)
+    (void)Cy_PdStack_Dpm_SetSchedHook(CY_PDSTACK_SCHED_HOOK_PPS_STREAM, Cy_PdStack_Dpm_PpsStreamTask);
+    (void)Cy_PdStack_Dpm_SetPendingWork(ptrPdStackContext, CY_PDSTACK_PEND_APP);
+#else
+    CY_UNUSED_PARAMETER(ptrPdStackContext);
+#endif /* (CY_PD_EVENT_DRIVEN_TASK_ENABLE) */
+}
+
+static void stream_retry_cbk(cy_timer_id_t id, void *callbackContext)
+{
+    cy_stc_pdstack_context_t *ptrPdStackContext = (cy_stc_pdstack_context_t *)callbackContext;
+    stream_port_t *ptrStream = stream_get(ptrPdStackContext);
+
+    CY_UNUSED_PARAMETER(id);
+
+    if (ptrStream != NULL)
+    {
+#if (CY_PD_TRACE_ENABLE)
+        Cy_PdStack_Dpm_TraceWrite(ptrPdStackContext, CY_PDSTACK_TRACE_TIMER, 0u, (uint16_t)id);
+#endif /* (CY_PD_TRACE_ENABLE) */
+        ptrStream->holdOff = false;
+        stream_kick(ptrPdStackContext);
+    }
+}
+
+static void stream_hold_off(cy_stc_pdstack_context_t *ptrPdStackContext, stream_port_t *ptrStream)
+{
+    if ((ptrPdStackContext->ptrTimerContext != NULL) &&
+            (Cy_PdUtils_SwTimer_Start(ptrPdStackContext->ptrTimerContext, ptrPdStackContext,
+                                      STREAM_TIMER_ID(ptrPdStackContext),
+                                      CY_PDSTACK_PPS_STREAM_RETRY_PERIOD, stream_retry_cbk)))
+    {
+        ptrStream->holdOff = true;
+    }
+}
+
+static void stream_stop(cy_stc_pdstack_context_t *ptrPdStackContext, stream_port_t *ptrStream)
+{
+    ptrStream->stat.active   = false;
+    ptrStream->stat.inFlight = false;
+    ptrStream->retry         = false;
+    ptrStream->holdOff       = false;
+
+    if (ptrPdStackContext->ptrTimerContext != NULL)
+    {
+        Cy_PdUtils_SwTimer_Stop(ptrPdStackContext->ptrTimerContext, STREAM_TIMER_ID(ptrPdStackContext));
+    }
+}
+
+/* Decodes the operating point carried by a PPS or AVS RDO. */
+static void stream_decode_rdo(const stream_port_t *ptrStream, uint32_t rdo, uint16_t *ptrVolt, uint16_t *ptrCur)
+{
+    if (ptrStream->avs)
+    {
+        *ptrVolt = (uint16_t)(STREAM_FIELD(rdo, 9u, 0xFFFu) * 25u);
+    }
+    else
+    {
+        *ptrVolt = (uint16_t)(STREAM_FIELD(rdo, 9u, 0xFFFu) * 20u);
+    }
+    *ptrCur = (uint16_t)(STREAM_FIELD(rdo, 0u, 0x7Fu) * STREAM_CUR_STEP);
+}
+
+static void stream_cmd_cbk(cy_stc_pdstack_context_t *ptrPdStackContext, cy_en_pdstack_resp_status_t resp,
+        const cy_stc_pdstack_pd_packet_t *pkt_ptr)
+{
+    stream_port_t *ptrStream = stream_get(ptrPdStackContext);
+
+    if ((ptrStream == NULL) || (!ptrStream->stat.inFlight) || (resp == CY_PDSTACK_CMD_SENT))
+    {
+        return;
+    }
+
+    if ((resp == CY_PDSTACK_RES_RCVD) && (pkt_ptr != NULL))
+    {
+        switch (pkt_ptr->msg)
+        {
+            case STREAM_MSG_ACCEPT:
+                /* Completed by APP_EVT_PD_CONTRACT_NEGOTIATION_COMPLETE after PS_RDY. */
+                return;
+
+            case STREAM_MSG_REJECT:
+                /* The setpoint cannot be met; wait for a new one. */
+                ptrStream->stat.rejectCount++;
+                ptrStream->stat.inFlight = false;
+                return;
+
+            case STREAM_MSG_WAIT:
+                ptrStream->stat.waitCount++;
+                break;
+
+            default:
+                ptrStream->stat.failCount++;
+                break;
+        }
+    }
+    else
+    {
+        ptrStream->stat.failCount++;
+    }
+
+    /* Wait or failure: resend the latest setpoint after tSinkRequest. */
+    ptrStream->stat.inFlight = false;
+    ptrStream->retry         = true;
+    stream_hold_off(ptrPdStackContext, ptrStream);
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_PpsStreamStart(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        uint8_t pdoPos)
+{
+    stream_port_t *ptrStream = stream_get(ptrPdStackContext);
+    const cy_stc_pdstack_pd_packet_t *srcCap;
+    uint32_t pdo;
+    uint8_t count;
+
+    if (ptrStream == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    srcCap = ptrPdStackContext->dpmStat.srcCapP;
+    if (srcCap == NULL)
+    {
+        return CY_PDSTACK_STAT_NOT_READY;
+    }
+
+    count = srcCap->len;
+    if (count > (CY_PD_MAX_NO_OF_DO + CY_PD_MAX_NO_OF_EPR_PDO))
+    {
+        count = (CY_PD_MAX_NO_OF_DO + CY_PD_MAX_NO_OF_EPR_PDO);
+    }
+    if ((pdoPos == 0u) || (pdoPos > count))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    pdo = srcCap->dat[pdoPos - 1u].val;
+    if (STREAM_FIELD(pdo, 30u, 0x3u) != STREAM_PDO_APDO)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    stream_stop(ptrPdStackContext, ptrStream);
+
+    if (STREAM_FIELD(pdo, 28u, 0x3u) == STREAM_APDO_PPS)
+    {
+        ptrStream->avs     = false;
+        ptrStream->maxVolt = (uint16_t)(STREAM_FIELD(pdo, 17u, 0xFFu) * 100u);
+        ptrStream->minVolt = (uint16_t)(STREAM_FIELD(pdo, 8u, 0xFFu) * 100u);
+        ptrStream->maxCur  = (uint16_t)(STREAM_FIELD(pdo, 0u, 0x7Fu) * STREAM_CUR_STEP);
+        ptrStream->pdp     = 0u;
+    }
+    else if ((STREAM_FIELD(pdo, 28u, 0x3u) == STREAM_APDO_EPR_AVS) &&
+            (CY_PDSTACK_CFG_EPR_ACTIVE(ptrPdStackContext)))
+    {
+        ptrStream->avs     = true;
+        ptrStream->maxVolt = (uint16_t)(STREAM_FIELD(pdo, 17u, 0x1FFu) * 100u);
+        ptrStream->minVolt = (uint16_t)(STREAM_FIELD(pdo, 8u, 0xFFu) * 100u);
+        ptrStream->maxCur  = 0u;
+        ptrStream->pdp     = (uint8_t)STREAM_FIELD(pdo, 0u, 0xFFu);
+    }
+    else
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    if ((ptrStream->minVolt == 0u) || (ptrStream->minVolt > ptrStream->maxVolt))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    ptrStream->pdo          = pdo;
+    ptrStream->doneSeq      = ptrStream->mboxSeq;
+    ptrStream->stat.pdoPos  = pdoPos;
+    ptrStream->stat.active  = true;
+
+    /* Start from the operating point of the current contract if it is on this APDO. */
+    ptrStream->stat.achievedVolt = 0u;
+    ptrStream->stat.achievedCur  = 0u;
+    if (STREAM_FIELD(ptrPdStackContext->dpmStat.snkRdo.val, STREAM_RDO_POS_POS, 0xFu) == pdoPos)
+    {
+        stream_decode_rdo(ptrStream, ptrPdStackContext->dpmStat.snkRdo.val,
+                &ptrStream->stat.achievedVolt, &ptrStream->stat.achievedCur);
+    }
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_PpsStreamStop(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    stream_port_t *ptrStream = stream_get(ptrPdStackContext);
+
+    if (ptrStream == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    stream_stop(ptrPdStackContext, ptrStream);
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_PpsStreamSetTarget(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        uint16_t volt,
+        uint16_t cur)
+{
+    stream_port_t *ptrStream = stream_get(ptrPdStackContext);
+    uint32_t intrState;
+
+    if (ptrStream == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    if (!ptrStream->stat.active)
+    {
+        return CY_PDSTACK_STAT_NOT_READY;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    if (ptrStream->mboxSeq != ptrStream->doneSeq)
+    {
+        ptrStream->stat.mergeCount++;
+    }
+    ptrStream->mboxVolt     = volt;
+    ptrStream->mboxCur      = cur;
+    ptrStream->stat.reqVolt = volt;
+    ptrStream->stat.reqCur  = cur;
+    ptrStream->mboxSeq++;
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    stream_kick(ptrPdStackContext);
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_PpsStreamTask(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    stream_port_t *ptrStream = stream_get(ptrPdStackContext);
+    cy_en_pdstack_dpm_pd_cmd_t cmd = CY_PDSTACK_DPM_CMD_SEND_REQUEST;
+    uint32_t intrState;
+    uint32_t rdo;
+    uint32_t maxCur;
+    uint16_t volt;
+    uint16_t cur;
+    uint16_t step;
+    uint8_t seq;
+
+    if (ptrStream == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    if ((!ptrStream->stat.active) || (ptrStream->stat.inFlight) || (ptrStream->holdOff) ||
+            ((ptrStream->mboxSeq == ptrStream->doneSeq) && (!ptrStream->retry)))
+    {
+        return CY_PDSTACK_STAT_SUCCESS;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    volt = ptrStream->mboxVolt;
+    cur  = ptrStream->mboxCur;
+    seq  = ptrStream->mboxSeq;
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    /* Clamp to the APDO and round down to the request resolution. */
+    step = (ptrStream->avs) ? STREAM_AVS_VOLT_STEP : STREAM_PPS_VOLT_STEP;
+    if (volt < ptrStream->minVolt)
+    {
+        volt = ptrStream->minVolt;
+    }
+    if (volt > ptrStream->maxVolt)
+    {
+        volt = ptrStream->maxVolt;
+    }
+    volt = (uint16_t)((volt / step) * step);
+
+    maxCur = (ptrStream->avs) ? (((uint32_t)ptrStream->pdp * 100000u) / volt) : ptrStream->maxCur;
+    if (maxCur > (0x7Fu * STREAM_CUR_STEP))
+    {
+        maxCur = (0x7Fu * STREAM_CUR_STEP);
+    }
+    if (cur > maxCur)
+    {
+        cur = (uint16_t)maxCur;
+    }
+    cur = (uint16_t)((cur / STREAM_CUR_STEP) * STREAM_CUR_STEP);
+
+    /* Nothing to negotiate if the contract already has this operating point. */
+    if ((volt == ptrStream->stat.achievedVolt) && (cur == ptrStream->stat.achievedCur))
+    {
+        ptrStream->doneSeq = seq;
+        ptrStream->retry   = false;
+        return CY_PDSTACK_STAT_SUCCESS;
+    }
+
+    rdo = ((uint32_t)ptrStream->stat.pdoPos << STREAM_RDO_POS_POS);
+    if (ptrPdStackContext->dpmStat.snkUsbCommEn != 0u)
+    {
+        rdo |= STREAM_RDO_USB_COMM;
+    }
+    if (ptrPdStackContext->dpmStat.snkUsbSuspEn == 0u)
+    {
+        rdo |= STREAM_RDO_NO_USB_SUSP;
+    }
+    if (CY_PDSTACK_CFG_EPR_SNK_EN(ptrPdStackContext))
+    {
+        rdo |= STREAM_RDO_EPR_CAPABLE;
+    }
+
+    if (ptrStream->avs)
+    {
+        /* Output voltage in 25 mV units with the two LSBs zero. */
+        rdo |= ((((uint32_t)volt / 25u) & 0xFFCu) << 9u);
+    }
+    else
+    {
+        rdo |= ((((uint32_t)volt / 20u) & 0xFFFu) << 9u);
+    }
+    rdo |= (((uint32_t)cur / STREAM_CUR_STEP) & 0x7Fu);
+
+    ptrStream->cmdBuf.cmdSop       = CY_PD_SOP;
+    ptrStream->cmdBuf.cmdDo[0].val = rdo;
+    ptrStream->cmdBuf.noOfCmdDo    = 1u;
+    ptrStream->cmdBuf.timeout      = 0u;
+
+    /* Every request in EPR mode is an EPR_Request carrying a copy of the PDO. */
+    if (CY_PDSTACK_CFG_EPR_ACTIVE(ptrPdStackContext))
+    {
+        cmd = CY_PDSTACK_DPM_CMD_SEND_EPR_REQUEST;
+        ptrStream->cmdBuf.cmdDo[1].val = ptrStream->pdo;
+        ptrStream->cmdBuf.noOfCmdDo    = 2u;
+    }
+
+    ptrStream->stat.inFlight = true;
+    if (Cy_PdStack_Dpm_SendPdCommand(ptrPdStackContext, cmd, &ptrStream->cmdBuf, false,
+                stream_cmd_cbk) != CY_PDSTACK_STAT_SUCCESS)
+    {
+        /* Stack busy with another AMS; retried on the next task call. */
+        ptrStream->stat.inFlight = false;
+        return CY_PDSTACK_STAT_SUCCESS;
+    }
+
+    ptrStream->doneSeq       = seq;
+    ptrStream->retry         = false;
+    ptrStream->stat.sentVolt = volt;
+    ptrStream->stat.sentCur  = cur;
+    ptrStream->stat.requestCount++;
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+void Cy_PdStack_Dpm_PpsStreamEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data)
+{
+    stream_port_t *ptrStream = stream_get(ptrPdStackContext);
+    const cy_stc_pdstack_pd_contract_info_t *ptrInfo;
+    uint32_t rdo;
+
+    if ((ptrStream == NULL) || (!ptrStream->stat.active))
+    {
+        return;
+    }
+
+    switch (evt)
+    {
+        case APP_EVT_PD_CONTRACT_NEGOTIATION_COMPLETE:
+            ptrInfo = (const cy_stc_pdstack_pd_contract_info_t *)data;
+            if (ptrInfo == NULL)
+            {
+                break;
+            }
+
+            if ((ptrInfo->status == CY_PDSTACK_CONTRACT_NEGOTIATION_SUCCESSFUL) ||
+                    (ptrInfo->status == CY_PDSTACK_CONTRACT_CAP_MISMATCH_DETECTED))
+            {
+                rdo = ptrInfo->rdo.val;
+                if (STREAM_FIELD(rdo, STREAM_RDO_POS_POS, 0xFu) != ptrStream->stat.pdoPos)
+                {
+                    /* Renegotiated onto another PDO, e.g. after new source capabilities. */
+                    stream_stop(ptrPdStackContext, ptrStream);
+                    break;
+                }
+
+                stream_decode_rdo(ptrStream, rdo, &ptrStream->stat.achievedVolt, &ptrStream->stat.achievedCur);
+                if (ptrStream->stat.inFlight)
+                {
+                    ptrStream->stat.acceptCount++;
+                }
+            }
+            else if ((ptrInfo->status == CY_PDSTACK_CONTRACT_REJECT_EXPLICIT_CONTRACT) &&
+                    (ptrStream->stat.inFlight))
+            {
+                ptrStream->stat.rejectCount++;
+            }
+            else
+            {
+                /* Remaining failures end in a hard reset, reported separately. */
+            }
+
+            /* PS_RDY received: the next request may be sent right away. */
+            ptrStream->stat.inFlight = false;
+            stream_kick(ptrPdStackContext);
+            break;
+
+        case APP_EVT_DISCONNECT:
+        case APP_EVT_TYPE_C_ERROR_RECOVERY:
+        case APP_EVT_HARD_RESET_RCVD:
+        case APP_EVT_HARD_RESET_SENT:
+        case APP_EVT_PE_DISABLED:
+            stream_stop(ptrPdStackContext, ptrStream);
+            break;
+
+        default:
+            /* No action required. */
+            break;
+    }
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_PpsStreamGetStatus(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_pps_stream_status_t *ptrStatus)
+{
+    stream_port_t *ptrStream = stream_get(ptrPdStackContext);
+    uint32_t intrState;
+
+    if ((ptrStream == NULL) || (ptrStatus == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    *ptrStatus = ptrStream->stat;
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+#endif /* ((CY_PD_PPS_STREAM_ENABLE) && (CY_PDSTACK_CFG_SNK_SUPP) && (CY_PDSTACK_CFG_PPS_SUPP)) */
+
+/* [] END OF FILE */
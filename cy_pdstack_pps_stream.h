@@ -0,0 +1,220 @@
+/***************************************************************************//**
+* \file cy_pdstack_pps_stream.h
+* \version 4.0
+*
+* Header file of the PPS/AVS streaming request mode of the PDStack middleware.
+* The application posts voltage and current setpoints, which are merged and
+* sent as Request (or EPR_Request) messages as fast as the power negotiation
+* allows.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_PPS_STREAM_H)
+#define CY_PDSTACK_PPS_STREAM_H
+
+#include "cy_pdstack_common.h"
+
+/**
+* \addtogroup group_pdstack_macros
+* \{
+*/
+
+#ifndef CY_PDSTACK_PPS_STREAM_TIMER_BASE_ID
+/** Soft timer ID used by the streaming mode on port 0. Port N uses this ID plus
+ * N. Can be overridden to move the timers within the application timer range. */
+#define CY_PDSTACK_PPS_STREAM_TIMER_BASE_ID     (CY_PDUTILS_TIMER_APP_PORT0_START_ID + 0xF0u)
+#if (CY_PD_MAX_NO_OF_PORTS > 8u)
+#error "The default PPS stream timer IDs overlap the event coalescing timer IDs beyond 8 ports; override CY_PDSTACK_PPS_STREAM_TIMER_BASE_ID."
+#endif
+#endif /* CY_PDSTACK_PPS_STREAM_TIMER_BASE_ID */
+
+/** Delay in ms before a request is retried after a Wait response or a failed
+ * request (tSinkRequest). */
+#define CY_PDSTACK_PPS_STREAM_RETRY_PERIOD      (100u)
+
+/** \} group_pdstack_macros */
+
+/**
+* \addtogroup group_pdstack_data_structures
+* \{
+*/
+
+/**
+ * @brief Status of the PPS/AVS streaming mode of a port. Voltages are in mV
+ * and currents in 10 mA units.
+ */
+typedef struct
+{
+    bool        active;             /**< Streaming mode is active. */
+    bool        inFlight;           /**< A request is being negotiated. */
+    uint8_t     pdoPos;             /**< Object position of the streamed APDO. */
+    uint16_t    reqVolt;            /**< Last setpoint posted by the application. */
+    uint16_t    reqCur;             /**< Last setpoint posted by the application. */
+    uint16_t    sentVolt;           /**< Operating point of the last request sent. */
+    uint16_t    sentCur;            /**< Operating point of the last request sent. */
+    uint16_t    achievedVolt;       /**< Operating point of the current contract. */
+    uint16_t    achievedCur;        /**< Operating point of the current contract. */
+    uint32_t    requestCount;       /**< Number of requests sent. */
+    uint32_t    acceptCount;        /**< Number of requests completed with PS_RDY. */
+    uint32_t    rejectCount;        /**< Number of requests rejected by the source. */
+    uint32_t    waitCount;          /**< Number of requests answered with Wait. */
+    uint32_t    failCount;          /**< Number of requests which failed or timed out. */
+    uint32_t    mergeCount;         /**< Number of setpoints replaced before being sent. */
+} cy_stc_pdstack_pps_stream_status_t;
+
+/** \} group_pdstack_data_structures */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_PpsStreamStart
+****************************************************************************//**
+*
+* Starts the streaming mode on a PPS APDO, or while in EPR mode on an EPR AVS
+* APDO, of the last received source capabilities. Setpoints posted through
+* Cy_PdStack_Dpm_PpsStreamSetTarget are then converted to requests on this
+* APDO. The stack keeps handling the PPS keepalive (tPPSRequest) through
+* Cy_PdStack_Dpm_PpsTask.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param pdoPos
+* Object position (1-based) of the APDO in the source capabilities.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_NOT_READY if no source capabilities have been received.
+* CY_PDSTACK_STAT_BAD_PARAM if the parameters are invalid or the object is not
+* a supported APDO.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_PpsStreamStart(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        uint8_t pdoPos);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_PpsStreamStop
+****************************************************************************//**
+*
+* Stops the streaming mode. A request which is already being negotiated is
+* completed by the stack; the current contract is kept.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the parameters are invalid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_PpsStreamStop(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_PpsStreamSetTarget
+****************************************************************************//**
+*
+* Posts a new setpoint. Only the latest setpoint is kept; one posted while a
+* request is being negotiated replaces any earlier one which has not been sent
+* yet. The setpoint is clamped to the APDO limits and rounded down to the
+* request resolution (20 mV for PPS, 100 mV for EPR AVS, 50 mA). Can be called
+* from interrupt context.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param volt
+* Target voltage in mV.
+*
+* \param cur
+* Target operating current in 10 mA units.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_NOT_READY if the streaming mode is not active.
+* CY_PDSTACK_STAT_BAD_PARAM if the parameters are invalid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_PpsStreamSetTarget(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        uint16_t volt,
+        uint16_t cur);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_PpsStreamTask
+****************************************************************************//**
+*
+* Sends the latest setpoint if no request is being negotiated. Called from
+* Cy_PdStack_Dpm_TaskPending when CY_PD_EVENT_DRIVEN_TASK_ENABLE is set;
+* otherwise it must be called after Cy_PdStack_Dpm_Task.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the parameters are invalid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_PpsStreamTask(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_PpsStreamEventHandler
+****************************************************************************//**
+*
+* Tracks contract completion and connection events. Must be called from the
+* application event handler for every event.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param evt
+* Event ID.
+*
+* \param data
+* Event data.
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_PpsStreamEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_PpsStreamGetStatus
+****************************************************************************//**
+*
+* Reports the requested, sent and achieved operating points and the request
+* counters of the port.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrStatus
+* Output parameter which receives the status.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the parameters are invalid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_PpsStreamGetStatus(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_pps_stream_status_t *ptrStatus);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_PPS_STREAM_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,232 @@
+/***************************************************************************//**
+* \file cy_pdstack_prl_stats.c
+* \version 4.0
+*
+* Source file of the protocol layer statistics of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "cy_syslib.h"
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_prl_stats.h"
+
+#if (CY_PD_PRL_STATS_ENABLE)
+
+/* Saturating increment of a 16 bit counter. */
+#define PRL_STATS_INC(cntr)                                                     \
+    do                                                                          \
+    {                                                                           \
+        if ((cntr) != 0xFFFFu)                                                  \
+        {                                                                       \
+            (cntr)++;                                                           \
+        }                                                                       \
+    } while (false)
+
+typedef struct
+{
+    cy_stc_pdstack_prl_stats_t          stat;
+
+    /* Notification callback of the policy engine which is wrapped. */
+    cy_pdstack_pd_cbk_t                 peCbk;
+} prl_port_t;
+
+static prl_port_t gl_prlStats[CY_PD_MAX_NO_OF_PORTS];
+
+static prl_port_t *prl_get(const cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    if ((ptrPdStackContext == NULL) || (ptrPdStackContext->port >= CY_PD_MAX_NO_OF_PORTS))
+    {
+        return NULL;
+    }
+
+    return &gl_prlStats[ptrPdStackContext->port];
+}
+
+static cy_stc_pdstack_prl_sop_stats_t *prl_sop(prl_port_t *ptrPrl, cy_en_pd_sop_t sop)
+{
+    if ((uint8_t)sop >= CY_PDSTACK_PRL_STATS_SOP_TYPES)
+    {
+        return NULL;
+    }
+
+    return &ptrPrl->stat.sop[sop];
+}
+
+/* Runs in the protocol layer context, which can be an interrupt. */
+static void prl_cbk(cy_stc_pdstack_context_t *ptrPdStackContext, uint32_t event)
+{
+    prl_port_t *ptrPrl = &gl_prlStats[ptrPdStackContext->port];
+    cy_stc_pdstack_prl_sop_stats_t *ptrSop;
+
+    ptrSop = prl_sop(ptrPrl, ptrPdStackContext->pdStat.txSop);
+    if (ptrSop != NULL)
+    {
+        if ((event & CY_PD_PE_EVT_TX_SUCCESS) != 0u)
+        {
+            PRL_STATS_INC(ptrSop->txCount);
+        }
+        if ((event & CY_PD_PE_EVT_TX_FAIL) != 0u)
+        {
+            PRL_STATS_INC(ptrSop->txFailCount);
+        }
+        if ((event & CY_PD_PE_EVT_TX_DISCARDED) != 0u)
+        {
+            PRL_STATS_INC(ptrSop->txDiscardCount);
+        }
+    }
+
+    ptrSop = prl_sop(ptrPrl, ptrPdStackContext->pdStat.lastRcvdSop);
+    if (ptrSop != NULL)
+    {
+        if ((event & CY_PD_PE_EVT_PKT_RCVD) != 0u)
+        {
+            PRL_STATS_INC(ptrSop->rxCount);
+        }
+        if ((event & CY_PD_PE_EVT_CRC_ERROR) != 0u)
+        {
+            PRL_STATS_INC(ptrSop->rxCrcErrCount);
+        }
+    }
+
+    if (ptrPrl->peCbk != NULL)
+    {
+        ptrPrl->peCbk(ptrPdStackContext, event);
+    }
+}
+
+/* The stack may install its callback again when the protocol layer restarts. */
+static void prl_hook(cy_stc_pdstack_context_t *ptrPdStackContext, prl_port_t *ptrPrl)
+{
+    uint32_t intrState;
+
+    if ((ptrPdStackContext->pdStat.cbk != NULL) && (ptrPdStackContext->pdStat.cbk != prl_cbk))
+    {
+        intrState = Cy_SysLib_EnterCriticalSection();
+        ptrPrl->peCbk                   = ptrPdStackContext->pdStat.cbk;
+        ptrPdStackContext->pdStat.cbk   = prl_cbk;
+        Cy_SysLib_ExitCriticalSection(intrState);
+    }
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_PrlStatsInit(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    prl_port_t *ptrPrl = prl_get(ptrPdStackContext);
+
+    if (ptrPrl == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    if (ptrPdStackContext->pdStat.cbk == NULL)
+    {
+        return CY_PDSTACK_STAT_NOT_READY;
+    }
+
+    (void)Cy_PdStack_Dpm_ClearPrlStats(ptrPdStackContext);
+    prl_hook(ptrPdStackContext, ptrPrl);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+void Cy_PdStack_Dpm_PrlStatsEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data)
+{
+    prl_port_t *ptrPrl = prl_get(ptrPdStackContext);
+    uint8_t reason = (uint8_t)CY_PDSTACK_HARDRES_REASON_NONE;
+
+    CY_UNUSED_PARAMETER(data);
+
+    if ((ptrPrl == NULL) || (ptrPrl->peCbk == NULL))
+    {
+        return;
+    }
+
+    prl_hook(ptrPdStackContext, ptrPrl);
+
+    switch (evt)
+    {
+        case APP_EVT_HARD_RESET_SENT:
+#if DPM_DEBUG_SUPPORT
+            if (ptrPdStackContext->dpmStat.hardResetReason < CY_PDSTACK_PRL_STATS_HR_REASONS)
+            {
+                reason = ptrPdStackContext->dpmStat.hardResetReason;
+            }
+#endif /* DPM_DEBUG_SUPPORT */
+            PRL_STATS_INC(ptrPrl->stat.hardResetSent[reason]);
+            break;
+
+        case APP_EVT_HARD_RESET_RCVD:
+            PRL_STATS_INC(ptrPrl->stat.hardResetRcvd);
+            break;
+
+        case APP_EVT_RP_CHANGE:
+            if ((ptrPdStackContext->dpmConfig.curPortRole == (uint8_t)CY_PD_PRT_ROLE_SINK) &&
+                    (ptrPdStackContext->dpmConfig.contractExist) &&
+                    (ptrPdStackContext->dpmConfig.specRevSopLive >= CY_PD_REV3))
+            {
+                PRL_STATS_INC(ptrPrl->stat.sinkTxChangeCount);
+            }
+            break;
+
+        default:
+            /* Counted by the protocol layer callback. */
+            break;
+    }
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_GetPrlStats(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_prl_stats_t *ptrStats,
+        bool clear)
+{
+    prl_port_t *ptrPrl = prl_get(ptrPdStackContext);
+    uint32_t intrState;
+
+    if ((ptrPrl == NULL) || (ptrStats == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    *ptrStats = ptrPrl->stat;
+    if (clear)
+    {
+        (void)memset(&ptrPrl->stat, 0, sizeof(cy_stc_pdstack_prl_stats_t));
+    }
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_ClearPrlStats(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    prl_port_t *ptrPrl = prl_get(ptrPdStackContext);
+    uint32_t intrState;
+
+    if (ptrPrl == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    (void)memset(&ptrPrl->stat, 0, sizeof(cy_stc_pdstack_prl_stats_t));
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+#endif /* (CY_PD_PRL_STATS_ENABLE) */
+
+/* [] END OF FILE */
@@ -0,0 +1,180 @@
+/***************************************************************************//**
+* \file cy_pdstack_prl_stats.h
+* \version 4.0
+*
+* Header file of the protocol layer statistics of the PDStack middleware.
+* The notifications of the protocol layer to the policy engine are counted per
+* SOP type in saturating counters, together with the PD 3.0 collision
+* avoidance stalls and the hard resets by reason, for field telemetry.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_PRL_STATS_H)
+#define CY_PDSTACK_PRL_STATS_H
+
+#include "cy_pdstack_common.h"
+
+/**
+* \addtogroup group_pdstack_macros
+* \{
+*/
+
+/** Number of SOP types counted: SOP, SOP' and SOP''. */
+#define CY_PDSTACK_PRL_STATS_SOP_TYPES          ((uint8_t)CY_PD_SOP_DPRIME + 1u)
+
+/** Number of hard reset reasons counted, indexed by
+ * cy_en_pdstack_hard_reset_reason_t. */
+#define CY_PDSTACK_PRL_STATS_HR_REASONS         ((uint8_t)CY_PDSTACK_HARDRES_REASON_AMS_ERROR + 1u)
+
+/** \} group_pdstack_macros */
+
+/**
+* \addtogroup group_pdstack_data_structures
+* \{
+*/
+
+/**
+ * @brief Protocol layer counters of one SOP type. All counters saturate at
+ * 0xFFFF.
+ */
+typedef struct
+{
+    uint16_t    txCount;            /**< Messages sent and acknowledged with GoodCRC. */
+    uint16_t    txFailCount;        /**< Messages without GoodCRC after all retries. */
+    uint16_t    txDiscardCount;     /**< Messages discarded because of a collision with an incoming message. */
+    uint16_t    rxCount;            /**< Messages received. */
+    uint16_t    rxCrcErrCount;      /**< Messages received with a CRC failure, each one retried by the partner.
+                                         Counted under the SOP type received last. */
+} cy_stc_pdstack_prl_sop_stats_t;
+
+/**
+ * @brief Protocol layer statistics of a port. All counters saturate at
+ * 0xFFFF.
+ */
+typedef struct
+{
+    /** Counters per SOP type, indexed by cy_en_pd_sop_t. */
+    cy_stc_pdstack_prl_sop_stats_t  sop[CY_PDSTACK_PRL_STATS_SOP_TYPES];
+
+    /** Hard resets sent, indexed by cy_en_pdstack_hard_reset_reason_t. The
+     * reason is only known with DPM_DEBUG_SUPPORT; all hard resets sent are
+     * counted under CY_PDSTACK_HARDRES_REASON_NONE otherwise. */
+    uint16_t                        hardResetSent[CY_PDSTACK_PRL_STATS_HR_REASONS];
+
+    /** Hard resets received. */
+    uint16_t                        hardResetRcvd;
+
+    /** SinkTxOK and SinkTxNG changes seen as PD 3.0 sink. Sink-initiated
+     * AMSes stall while the source holds SinkTxNG. */
+    uint16_t                        sinkTxChangeCount;
+} cy_stc_pdstack_prl_stats_t;
+
+/** \} group_pdstack_data_structures */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_PrlStatsInit
+****************************************************************************//**
+*
+* Clears the protocol layer statistics of a port and starts counting. The
+* protocol layer notification callback in pdStat is wrapped, so that each
+* notification is counted before it is passed on to the policy engine. To be
+* called after Cy_PdStack_Dpm_Init.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+* CY_PDSTACK_STAT_NOT_READY if the stack is not initialized yet.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_PrlStatsInit(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_PrlStatsEventHandler
+****************************************************************************//**
+*
+* Counts the hard resets and the PD 3.0 collision avoidance changes, and wraps
+* the protocol layer notification callback again if the stack has installed
+* it anew. To be called from the application event handler.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param evt
+* Event ID.
+*
+* \param data
+* Event data.
+*
+* \return
+* None
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_PrlStatsEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_GetPrlStats
+****************************************************************************//**
+*
+* Takes a consistent snapshot of the protocol layer statistics of a port and
+* optionally clears them in the same critical section, so that no count is
+* lost between two snapshots.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrStats
+* Output parameter which receives the statistics.
+*
+* \param clear
+* Clear the statistics after the snapshot if true.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_GetPrlStats(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_prl_stats_t *ptrStats,
+        bool clear);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_ClearPrlStats
+****************************************************************************//**
+*
+* Clears the protocol layer statistics of a port.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_ClearPrlStats(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_PRL_STATS_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,280 @@
+/***************************************************************************//**
+* \file cy_pdstack_recontract.c
+* \version 4.0
+*
+* Source file of the fast re-contract path of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_dpm.h"
+#include "cy_pdstack_recontract.h"
+
+#if (CY_PD_FAST_RECONTRACT_ENABLE)
+
+/* Object position field of the RDO. */
+#define RECONTRACT_RDO_POS_POS          (28u)
+#define RECONTRACT_RDO_POS_MASK         (0xFu)
+
+/* RDO bits which are reserved under PD 2.0: unchunked extended messages
+ * supported (B23) and EPR mode capable (B22). */
+#define RECONTRACT_RDO_REV3_MASK        ((1UL << 23u) | (1UL << 22u))
+
+/* APDO type in B31:30 of a PDO. */
+#define RECONTRACT_PDO_TYPE_POS         (30u)
+#define RECONTRACT_PDO_TYPE_APDO        (3u)
+
+typedef struct
+{
+    cy_pd_pd_do_t                       rdo;
+    cy_pd_pd_do_t                       selPdo;
+    bool                                epr;
+    bool                                valid;
+} recontract_rec_t;
+
+typedef struct
+{
+    cy_stc_pdstack_recontract_cfg_t     cfg;
+    recontract_rec_t                    snk;
+    recontract_rec_t                    src;
+    uint32_t                            fastCount;
+    uint32_t                            fullCount;
+    app_resp_t                          resp;
+} recontract_port_t;
+
+static recontract_port_t gl_recontract[CY_PD_MAX_NO_OF_PORTS];
+
+static recontract_port_t *recontract_get(const cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    if ((ptrPdStackContext == NULL) || (ptrPdStackContext->port >= CY_PD_MAX_NO_OF_PORTS))
+    {
+        return NULL;
+    }
+
+    return &gl_recontract[ptrPdStackContext->port];
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_RecontractInit(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        const cy_stc_pdstack_recontract_cfg_t *ptrCfg)
+{
+    recontract_port_t *ptrPort = recontract_get(ptrPdStackContext);
+
+    if ((ptrPort == NULL) || (ptrCfg == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    /* Each evaluation the port can receive must be answered, so the full
+     * evaluator of every power role of the port is required. */
+    if (((ptrPdStackContext->dpmStat.portRole != CY_PD_PRT_ROLE_SOURCE) && (ptrCfg->evalSrcCap == NULL)) ||
+            ((ptrPdStackContext->dpmStat.portRole != CY_PD_PRT_ROLE_SINK) && (ptrCfg->evalRdo == NULL)))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    (void)memset(ptrPort, 0, sizeof(recontract_port_t));
+    ptrPort->cfg = *ptrCfg;
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+void Cy_PdStack_Dpm_RecontractEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data)
+{
+    recontract_port_t *ptrPort = recontract_get(ptrPdStackContext);
+    const cy_stc_pdstack_pd_contract_info_t *ptrInfo = (const cy_stc_pdstack_pd_contract_info_t *)data;
+    recontract_rec_t *ptrRec;
+
+    if (ptrPort == NULL)
+    {
+        return;
+    }
+
+    switch (evt)
+    {
+        case APP_EVT_PD_CONTRACT_NEGOTIATION_COMPLETE:
+            if (ptrPdStackContext->dpmConfig.curPortRole == (uint8_t)CY_PD_PRT_ROLE_SINK)
+            {
+                ptrRec         = &ptrPort->snk;
+                ptrRec->selPdo = ptrPdStackContext->dpmStat.snkSelPdo;
+            }
+            else
+            {
+                ptrRec         = &ptrPort->src;
+                ptrRec->selPdo = ptrPdStackContext->dpmStat.srcSelPdo;
+            }
+
+            ptrRec->valid = ((ptrInfo != NULL) && (ptrInfo->status == CY_PDSTACK_CONTRACT_NEGOTIATION_SUCCESSFUL));
+            if (ptrRec->valid)
+            {
+                ptrRec->rdo = ptrInfo->rdo;
+                ptrRec->epr = CY_PDSTACK_CFG_EPR_ACTIVE(ptrPdStackContext);
+            }
+            break;
+
+        case APP_EVT_DISCONNECT:
+        case APP_EVT_HARD_RESET_RCVD:
+        case APP_EVT_HARD_RESET_SENT:
+        case APP_EVT_TYPE_C_ERROR_RECOVERY:
+        case APP_EVT_VBUS_PORT_DISABLE:
+            ptrPort->snk.valid = false;
+            ptrPort->src.valid = false;
+            break;
+
+        default:
+            /* Soft resets and swaps keep the contracts. */
+            break;
+    }
+}
+
+#if (CY_PDSTACK_CFG_SNK_SUPP)
+void Cy_PdStack_Dpm_RecontractEvalSrcCap(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        const cy_stc_pdstack_pd_packet_t *srcCap,
+        cy_pdstack_app_resp_cbk_t app_resp_handler)
+{
+    recontract_port_t *ptrPort = recontract_get(ptrPdStackContext);
+    const recontract_rec_t *ptrRec;
+    uint32_t pos;
+    uint32_t rdo;
+    bool rev2;
+
+    if ((ptrPort == NULL) || (srcCap == NULL) || (app_resp_handler == NULL))
+    {
+        return;
+    }
+
+    ptrRec = &ptrPort->snk;
+    pos    = (ptrRec->rdo.val >> RECONTRACT_RDO_POS_POS) & RECONTRACT_RDO_POS_MASK;
+    rev2   = (ptrPdStackContext->dpmConfig.specRevSopLive < CY_PD_REV3);
+
+    if ((ptrRec->valid) && (ptrRec->epr == CY_PDSTACK_CFG_EPR_ACTIVE(ptrPdStackContext)) &&
+            (pos != 0u) && (pos <= srcCap->len) && (srcCap->dat[pos - 1u].val == ptrRec->selPdo.val) &&
+            ((!rev2) || ((ptrRec->selPdo.val >> RECONTRACT_PDO_TYPE_POS) != RECONTRACT_PDO_TYPE_APDO)))
+    {
+        rdo = ptrRec->rdo.val;
+        if (rev2)
+        {
+            rdo &= ~RECONTRACT_RDO_REV3_MASK;
+        }
+
+        ptrPort->fastCount++;
+        ptrPort->resp.respDo.val = rdo;
+        ptrPort->resp.reqStatus  = CY_PDSTACK_REQ_ACCEPT;
+        app_resp_handler(ptrPdStackContext, &ptrPort->resp);
+        return;
+    }
+
+    ptrPort->fullCount++;
+    if (ptrPort->cfg.evalSrcCap != NULL)
+    {
+        ptrPort->cfg.evalSrcCap(ptrPdStackContext, srcCap, app_resp_handler);
+    }
+    else
+    {
+        /* Not initialized for the sink role: the source offer is rejected
+         * rather than left without a response. */
+        ptrPort->resp.respDo.val = 0u;
+        ptrPort->resp.reqStatus  = CY_PDSTACK_REQ_REJECT;
+        app_resp_handler(ptrPdStackContext, &ptrPort->resp);
+    }
+}
+#endif /* (CY_PDSTACK_CFG_SNK_SUPP) */
+
+#if (CY_PDSTACK_CFG_SRC_SUPP)
+void Cy_PdStack_Dpm_RecontractEvalRdo(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_pd_pd_do_t rdo,
+        cy_pdstack_app_resp_cbk_t app_resp_handler)
+{
+    recontract_port_t *ptrPort = recontract_get(ptrPdStackContext);
+    const recontract_rec_t *ptrRec;
+    uint32_t pos;
+
+    if ((ptrPort == NULL) || (app_resp_handler == NULL))
+    {
+        return;
+    }
+
+    /* As on the sink side, the requested position must still offer the PDO
+     * of the previous contract. */
+    ptrRec = &ptrPort->src;
+    pos    = (rdo.val >> RECONTRACT_RDO_POS_POS) & RECONTRACT_RDO_POS_MASK;
+    if ((ptrRec->valid) && (ptrRec->rdo.val == rdo.val) &&
+            (ptrRec->epr == CY_PDSTACK_CFG_EPR_ACTIVE(ptrPdStackContext)) &&
+            (pos != 0u) && (pos <= (CY_PD_MAX_NO_OF_PDO + CY_PD_MAX_NO_OF_EPR_PDO)) &&
+            (ptrPdStackContext->dpmStat.curSrcPdo[pos - 1u].val == ptrRec->selPdo.val) &&
+            (Cy_PdStack_Dpm_IsPrevContractValid(ptrPdStackContext) == CY_PDSTACK_STAT_SUCCESS))
+    {
+        ptrPort->fastCount++;
+        ptrPort->resp.respDo    = rdo;
+        ptrPort->resp.reqStatus = CY_PDSTACK_REQ_ACCEPT;
+        app_resp_handler(ptrPdStackContext, &ptrPort->resp);
+        return;
+    }
+
+    ptrPort->fullCount++;
+    if (ptrPort->cfg.evalRdo != NULL)
+    {
+        ptrPort->cfg.evalRdo(ptrPdStackContext, rdo, app_resp_handler);
+    }
+    else
+    {
+        /* Not initialized for the source role: the request is rejected
+         * rather than left without a response. */
+        ptrPort->resp.respDo    = rdo;
+        ptrPort->resp.reqStatus = CY_PDSTACK_REQ_REJECT;
+        app_resp_handler(ptrPdStackContext, &ptrPort->resp);
+    }
+}
+#endif /* (CY_PDSTACK_CFG_SRC_SUPP) */
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_RecontractInvalidate(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    recontract_port_t *ptrPort = recontract_get(ptrPdStackContext);
+
+    if (ptrPort == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    ptrPort->snk.valid = false;
+    ptrPort->src.valid = false;
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_RecontractGetStatus(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_recontract_status_t *ptrStatus)
+{
+    recontract_port_t *ptrPort = recontract_get(ptrPdStackContext);
+
+    if ((ptrPort == NULL) || (ptrStatus == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    ptrStatus->snkValid  = ptrPort->snk.valid;
+    ptrStatus->srcValid  = ptrPort->src.valid;
+    ptrStatus->fastCount = ptrPort->fastCount;
+    ptrStatus->fullCount = ptrPort->fullCount;
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+#endif /* (CY_PD_FAST_RECONTRACT_ENABLE) */
+
+/* [] END OF FILE */
@@ -0,0 +1,218 @@
+/***************************************************************************//**
+* \file cy_pdstack_recontract.h
+* \version 4.0
+*
+* Header file of the fast re-contract path of the PDStack middleware. The last
+* explicit contract of each power role is kept for the connection, and a
+* renegotiation after a soft reset, a PD revision downgrade or a power role
+* swap which finds the same offer is answered with the previous request or
+* acceptance without evaluating the capabilities again.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_RECONTRACT_H)
+#define CY_PDSTACK_RECONTRACT_H
+
+#include "cy_pdstack_common.h"
+
+/**
+* \addtogroup group_pdstack_data_structures
+* \{
+*/
+
+/**
+ * @brief Configuration of the fast re-contract path of a port. The handlers
+ * are called whenever the previous contract cannot be reused, usually the
+ * handlers set in the application callback structure before they were
+ * replaced by the functions of this module.
+ */
+typedef struct
+{
+    /** Full source capability evaluation, used as sink. Can only be NULL
+     * on source-only ports. */
+    void (*evalSrcCap)(cy_stc_pdstack_context_t *ptrPdStackContext,
+            const cy_stc_pdstack_pd_packet_t *srcCap, cy_pdstack_app_resp_cbk_t app_resp_handler);
+
+    /** Full request evaluation, used as source. Can only be NULL on
+     * sink-only ports. */
+    void (*evalRdo)(cy_stc_pdstack_context_t *ptrPdStackContext,
+            cy_pd_pd_do_t rdo, cy_pdstack_app_resp_cbk_t app_resp_handler);
+} cy_stc_pdstack_recontract_cfg_t;
+
+/**
+ * @brief Fast re-contract statistics of a port.
+ */
+typedef struct
+{
+    bool        snkValid;       /**< A sink contract is held. */
+    bool        srcValid;       /**< A source contract is held. */
+    uint32_t    fastCount;      /**< Negotiations answered from the previous contract. */
+    uint32_t    fullCount;      /**< Negotiations passed to the full evaluation. */
+} cy_stc_pdstack_recontract_status_t;
+
+/** \} group_pdstack_data_structures */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_RecontractInit
+****************************************************************************//**
+*
+* Enables the fast re-contract path of a port and drops the held contracts.
+* The application then sets Cy_PdStack_Dpm_RecontractEvalSrcCap as
+* eval_src_cap and Cy_PdStack_Dpm_RecontractEvalRdo as eval_rdo of the port.
+* Must be called after the stack has been initialized, as the evaluators
+* required are taken from the port role.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrCfg
+* Configuration. Copied by the function.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid, or if the
+* evaluator of a power role supported by the port is NULL.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_RecontractInit(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        const cy_stc_pdstack_recontract_cfg_t *ptrCfg);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_RecontractEventHandler
+****************************************************************************//**
+*
+* Records the contract of the current power role on
+* APP_EVT_PD_CONTRACT_NEGOTIATION_COMPLETE and drops the held contracts on
+* detach, hard reset, Type-C error recovery and port disable. Soft resets and
+* power role swaps keep them. To be called from the application event handler.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param evt
+* Event ID.
+*
+* \param data
+* Event data.
+*
+* \return
+* None
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_RecontractEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data);
+
+#if (CY_PDSTACK_CFG_SNK_SUPP)
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_RecontractEvalSrcCap
+****************************************************************************//**
+*
+* Implementation of the eval_src_cap application callback. If a sink contract
+* is held, the EPR mode state is unchanged and the source offers the same PDO
+* at the same object position, the previous RDO is reported at once. Bits
+* which are reserved under PD 2.0 are cleared after a revision downgrade, and
+* APDO contracts are not reused under PD 2.0. The evalSrcCap handler is used
+* otherwise.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param srcCap
+* Pointer to the received source capabilities.
+*
+* \param app_resp_handler
+* Callback through which the RDO is reported.
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_RecontractEvalSrcCap(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        const cy_stc_pdstack_pd_packet_t *srcCap,
+        cy_pdstack_app_resp_cbk_t app_resp_handler);
+#endif /* (CY_PDSTACK_CFG_SNK_SUPP) */
+
+#if (CY_PDSTACK_CFG_SRC_SUPP)
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_RecontractEvalRdo
+****************************************************************************//**
+*
+* Implementation of the eval_rdo application callback. If a source contract is
+* held, the EPR mode state is unchanged, the request is identical to the one
+* of that contract, the requested position still holds the PDO of that
+* contract and Cy_PdStack_Dpm_IsPrevContractValid reports that the source
+* capabilities still cover it, the request is accepted at once. The
+* evalRdo handler is used otherwise.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param rdo
+* Received RDO.
+*
+* \param app_resp_handler
+* Callback through which the decision is reported.
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_RecontractEvalRdo(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_pd_pd_do_t rdo,
+        cy_pdstack_app_resp_cbk_t app_resp_handler);
+#endif /* (CY_PDSTACK_CFG_SRC_SUPP) */
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_RecontractInvalidate
+****************************************************************************//**
+*
+* Drops the held contracts, for example after a change of the sink
+* capabilities which the previous request may no longer match.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_RecontractInvalidate(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_RecontractGetStatus
+****************************************************************************//**
+*
+* Reports the fast re-contract statistics of a port.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrStatus
+* Output parameter which receives the statistics.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_RecontractGetStatus(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_recontract_status_t *ptrStatus);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_RECONTRACT_H */
+
+/* [] END OF FILE */
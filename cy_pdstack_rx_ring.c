@@ -0,0 +1,120 @@
+/***************************************************************************//**
+* \file cy_pdstack_rx_ring.c
+* \version 4.0
+*
+* Source file of the received PD message ring of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "cy_syslib.h"
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_rx_ring.h"
+
+#if (CY_PD_RX_RING_ENABLE)
+
+#define RX_RING_MASK                    ((uint8_t)(CY_PD_RX_RING_DEPTH - 1u))
+
+cy_en_pdstack_status_t Cy_PdStack_RxRing_Init(
+        cy_stc_pdstack_rx_ring_t *ptrRing)
+{
+    if (ptrRing == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    ptrRing->wrIdx         = 0u;
+    ptrRing->rdIdx         = 0u;
+    ptrRing->highWatermark = 0u;
+    ptrRing->overflowCount = 0u;
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_RxRing_Push(
+        cy_stc_pdstack_rx_ring_t *ptrRing,
+        const cy_stc_pdstack_pd_packet_t *ptrPkt)
+{
+    uint8_t wr;
+    uint8_t count;
+
+    if ((ptrRing == NULL) || (ptrPkt == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    wr    = ptrRing->wrIdx;
+    count = (uint8_t)(wr - ptrRing->rdIdx);
+
+    if (count >= CY_PD_RX_RING_DEPTH)
+    {
+        if (ptrRing->overflowCount != 0xFFFFu)
+        {
+            ptrRing->overflowCount++;
+        }
+        return CY_PDSTACK_STAT_BUSY;
+    }
+
+    (void)memcpy(&ptrRing->pkt[wr & RX_RING_MASK], ptrPkt, sizeof(cy_stc_pdstack_pd_packet_t));
+
+    /* Slot contents must be visible before the index update publishes it. */
+    __DMB();
+    ptrRing->wrIdx = (uint8_t)(wr + 1u);
+
+    count++;
+    if (count > ptrRing->highWatermark)
+    {
+        ptrRing->highWatermark = count;
+    }
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_RxRing_Pop(
+        cy_stc_pdstack_rx_ring_t *ptrRing,
+        cy_stc_pdstack_pd_packet_t *ptrPkt)
+{
+    uint8_t rd;
+
+    if ((ptrRing == NULL) || (ptrPkt == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    rd = ptrRing->rdIdx;
+    if (rd == ptrRing->wrIdx)
+    {
+        return CY_PDSTACK_STAT_FAILURE;
+    }
+
+    __DMB();
+    (void)memcpy(ptrPkt, &ptrRing->pkt[rd & RX_RING_MASK], sizeof(cy_stc_pdstack_pd_packet_t));
+
+    /* Slot must be fully read before it is handed back to the producer. */
+    __DMB();
+    ptrRing->rdIdx = (uint8_t)(rd + 1u);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+uint8_t Cy_PdStack_RxRing_GetCount(
+        const cy_stc_pdstack_rx_ring_t *ptrRing)
+{
+    if (ptrRing == NULL)
+    {
+        return 0u;
+    }
+
+    return (uint8_t)(ptrRing->wrIdx - ptrRing->rdIdx);
+}
+
+#endif /* (CY_PD_RX_RING_ENABLE) */
+
+/* [] END OF FILE */
@@ -0,0 +1,140 @@
+/***************************************************************************//**
+* \file cy_pdstack_rx_ring.h
+* \version 4.0
+*
+* Header file of the received PD message ring of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_RX_RING_H)
+#define CY_PDSTACK_RX_RING_H
+
+#include "cy_pdstack_common.h"
+
+#if ((CY_PD_RX_RING_DEPTH == 0u) || (CY_PD_RX_RING_DEPTH > 128u) || \
+     ((CY_PD_RX_RING_DEPTH & (CY_PD_RX_RING_DEPTH - 1u)) != 0u))
+#error "CY_PD_RX_RING_DEPTH must be a power of two in the range 1 to 128."
+#endif
+
+/*******************************************************************************
+*                              Type definitions
+*******************************************************************************/
+
+/**
+* \addtogroup group_pdstack_data_structures
+* \{
+*/
+
+/**
+ * @brief Single-producer/single-consumer ring of received PD messages.
+ * The producer is the PDStack callback context (APP_EVT_PKT_RCVD handling)
+ * and the consumer is the application task. Neither side needs to
+ * disable interrupts.
+ */
+typedef struct
+{
+    cy_stc_pdstack_pd_packet_t pkt[CY_PD_RX_RING_DEPTH];   /**< Message slots. */
+    volatile uint8_t wrIdx;                                 /**< Free-running write index, producer owned. */
+    volatile uint8_t rdIdx;                                 /**< Free-running read index, consumer owned. */
+    volatile uint8_t highWatermark;                         /**< Highest ring occupancy seen, producer owned. */
+    volatile uint16_t overflowCount;                        /**< Messages dropped because the ring was full, producer owned. */
+} cy_stc_pdstack_rx_ring_t;
+
+/** \} group_pdstack_data_structures */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_RxRing_Init
+****************************************************************************//**
+*
+* Initializes the received message ring and clears its statistics.
+*
+* \param ptrRing
+* Pointer to the ring structure.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_RxRing_Init(
+        cy_stc_pdstack_rx_ring_t *ptrRing);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_RxRing_Push
+****************************************************************************//**
+*
+* Copies a received message into the ring. Must only be called from the
+* producer context. If the ring is full, the message is dropped and the
+* overflow counter is incremented.
+*
+* \param ptrRing
+* Pointer to the ring structure.
+*
+* \param ptrPkt
+* Pointer to the received message.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the message is queued.
+* CY_PDSTACK_STAT_BUSY if the ring is full.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_RxRing_Push(
+        cy_stc_pdstack_rx_ring_t *ptrRing,
+        const cy_stc_pdstack_pd_packet_t *ptrPkt);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_RxRing_Pop
+****************************************************************************//**
+*
+* Removes the oldest message from the ring. Must only be called from the
+* consumer context.
+*
+* \param ptrRing
+* Pointer to the ring structure.
+*
+* \param ptrPkt
+* Output parameter which receives a copy of the message.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if a message was returned.
+* CY_PDSTACK_STAT_FAILURE if the ring is empty.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_RxRing_Pop(
+        cy_stc_pdstack_rx_ring_t *ptrRing,
+        cy_stc_pdstack_pd_packet_t *ptrPkt);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_RxRing_GetCount
+****************************************************************************//**
+*
+* Returns the number of messages currently held in the ring.
+*
+* \param ptrRing
+* Pointer to the ring structure.
+*
+* \return
+* Number of queued messages. Zero if the ring pointer is NULL.
+*
+*******************************************************************************/
+uint8_t Cy_PdStack_RxRing_GetCount(
+        const cy_stc_pdstack_rx_ring_t *ptrRing);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_RX_RING_H */
+
+/* [] END OF FILE */
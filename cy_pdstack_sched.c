@@ -0,0 +1,514 @@
+/***************************************************************************//**
+* \file cy_pdstack_sched.c
+* \version 4.0
+*
+* Source file of the event-driven task scheduling support of the PDStack
+* middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include "cy_syslib.h"
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_dpm.h"
+#include "cy_pdstack_timer_id.h"
+#include "cy_pdstack_sched.h"
+#include "cy_pdstack_perf.h"
+#if (CY_PD_TRACE_ENABLE)
+#include "cy_pdstack_trace.h"
+#endif /* (CY_PD_TRACE_ENABLE) */
+
+#if (CY_PD_EVENT_DRIVEN_TASK_ENABLE)
+
+/* Flags posted from interrupt context, one word per port. */
+static volatile uint32_t gl_pendWork[CY_PD_MAX_NO_OF_PORTS];
+
+/* Deferred work installed by the optional modules on first use. */
+static cy_pdstack_sched_hook_t gl_schedHook[CY_PDSTACK_SCHED_HOOK_COUNT];
+
+#if (CY_PD_PERF_STATS_ENABLE)
+/* Time at which the first posted flag (timer or other) was set. */
+static uint32_t gl_pendStamp[CY_PD_MAX_NO_OF_PORTS];
+static uint32_t gl_timerStamp[CY_PD_MAX_NO_OF_PORTS];
+#endif /* (CY_PD_PERF_STATS_ENABLE) */
+
+static bool sched_ctx_valid(const cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    return ((ptrPdStackContext != NULL) && (ptrPdStackContext->port < CY_PD_MAX_NO_OF_PORTS));
+}
+
+/* Work which can be read out of the stack state without any posting. */
+static uint32_t sched_observed_work(cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    uint32_t pend = 0u;
+    bool sleepAllowed = true;
+
+    if (ptrPdStackContext->dpmStat.peEvt != 0u)
+    {
+        pend |= CY_PDSTACK_PEND_PE_EVT;
+    }
+
+    if (ptrPdStackContext->pdStat.rxEvt != 0u)
+    {
+        pend |= CY_PDSTACK_PEND_RX_EVT;
+    }
+
+    if ((ptrPdStackContext->dpmStat.dpmPdCmdActive) || (ptrPdStackContext->dpmStat.dpmTypecCmdActive))
+    {
+        pend |= CY_PDSTACK_PEND_DPM_CMD;
+    }
+
+    if ((Cy_PdStack_Dpm_IsSleepAllowed(ptrPdStackContext, &sleepAllowed) == CY_PDSTACK_STAT_SUCCESS) &&
+            (!sleepAllowed))
+    {
+        pend |= CY_PDSTACK_PEND_BUSY;
+    }
+
+    return pend;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_SetPendingWork(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        uint32_t pendMask)
+{
+    uint32_t intrState;
+
+    if (!sched_ctx_valid(ptrPdStackContext))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+#if (CY_PD_PERF_STATS_ENABLE)
+    if (((gl_pendWork[ptrPdStackContext->port] & ~CY_PDSTACK_PEND_TIMER) == 0u) &&
+            ((pendMask & ~CY_PDSTACK_PEND_TIMER) != 0u))
+    {
+        CY_PDSTACK_PERF_START(gl_pendStamp[ptrPdStackContext->port]);
+    }
+    if (((gl_pendWork[ptrPdStackContext->port] & CY_PDSTACK_PEND_TIMER) == 0u) &&
+            ((pendMask & CY_PDSTACK_PEND_TIMER) != 0u))
+    {
+        CY_PDSTACK_PERF_START(gl_timerStamp[ptrPdStackContext->port]);
+    }
+#endif /* (CY_PD_PERF_STATS_ENABLE) */
+    gl_pendWork[ptrPdStackContext->port] |= pendMask;
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    if ((ptrPdStackContext->ptrRtosContext != NULL) &&
+            (ptrPdStackContext->ptrRtosContext->dpm_rtos_evt_give != NULL))
+    {
+        (void)ptrPdStackContext->ptrRtosContext->dpm_rtos_evt_give(ptrPdStackContext);
+    }
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_SetSchedHook(
+        cy_en_pdstack_sched_hook_t slot,
+        cy_pdstack_sched_hook_t hook)
+{
+    if ((uint8_t)slot >= (uint8_t)CY_PDSTACK_SCHED_HOOK_COUNT)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    gl_schedHook[slot] = hook;
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_GetPendingWork(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        uint32_t *ptrPendMask)
+{
+    if ((!sched_ctx_valid(ptrPdStackContext)) || (ptrPendMask == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    *ptrPendMask = gl_pendWork[ptrPdStackContext->port] | sched_observed_work(ptrPdStackContext);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+/* Earliest expiry in ms of the running soft timers of the port. */
+static uint32_t sched_port_deadline(cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    cy_stc_pdutils_sw_timer_t *ptrTimer = ptrPdStackContext->ptrTimerContext;
+    cy_timer_id_t firstId;
+    cy_timer_id_t lastId;
+    cy_timer_id_t id;
+    uint32_t deadline = CY_PDSTACK_WAKEUP_NONE;
+
+    if (ptrTimer == NULL)
+    {
+        return deadline;
+    }
+
+    firstId = CY_PDSTACK_GET_PD_TIMER_ID(ptrPdStackContext, CY_PDSTACK_PD_CABLE_TIMER);
+    lastId  = CY_PDSTACK_GET_PD_TIMER_ID(ptrPdStackContext, CY_PDSTACK_PD_VCONN_RECOVERY_TIMER);
+
+    /* Skip the per-timer scan when none of the port timers is running. */
+    if (Cy_PdUtils_SwTimer_RangeEnabled(ptrTimer, firstId, lastId))
+    {
+        for (id = firstId; id <= lastId; id++)
+        {
+            if (Cy_PdUtils_SwTimer_IsRunning(ptrTimer, id))
+            {
+                uint32_t remain = Cy_PdUtils_SwTimer_GetCount(ptrTimer, id);
+                if (remain < deadline)
+                {
+                    deadline = remain;
+                }
+            }
+        }
+    }
+
+    return deadline;
+}
+
+/* Runs the task of a port whose posted flags have already been consumed. */
+static cy_en_pdstack_status_t sched_run(cy_stc_pdstack_context_t *ptrPdStackContext,
+        uint32_t posted, uint32_t observed, bool *ptrTaskRun)
+{
+    cy_en_pdstack_status_t stat = CY_PDSTACK_STAT_SUCCESS;
+    uint32_t pend = posted | observed;
+    uint8_t slot;
+    CY_PDSTACK_PERF_DECLARE(runStamp);
+
+#if (CY_PD_PERF_STATS_ENABLE)
+    if ((posted & ~CY_PDSTACK_PEND_TIMER) != 0u)
+    {
+        CY_PDSTACK_PERF_END(ptrPdStackContext, CY_PDSTACK_PERF_INTR_TO_TASK, gl_pendStamp[ptrPdStackContext->port]);
+    }
+    if ((posted & CY_PDSTACK_PEND_TIMER) != 0u)
+    {
+        CY_PDSTACK_PERF_END(ptrPdStackContext, CY_PDSTACK_PERF_TIMER_TO_TASK, gl_timerStamp[ptrPdStackContext->port]);
+    }
+#endif /* (CY_PD_PERF_STATS_ENABLE) */
+
+    if (pend != 0u)
+    {
+        /* A latched fault is handed to the stack before its task runs, so
+         * that the hard reset or Alert is started within this pass. */
+        if (gl_schedHook[CY_PDSTACK_SCHED_HOOK_FAULT] != NULL)
+        {
+            (void)gl_schedHook[CY_PDSTACK_SCHED_HOOK_FAULT](ptrPdStackContext);
+        }
+
+        CY_PDSTACK_PERF_START(runStamp);
+        stat = Cy_PdStack_Dpm_Task(ptrPdStackContext);
+        CY_PDSTACK_PERF_END(ptrPdStackContext, CY_PDSTACK_PERF_TASK_RUN, runStamp);
+
+#if (CY_PD_TRACE_ENABLE)
+        Cy_PdStack_Dpm_TracePoll(ptrPdStackContext);
+#endif /* (CY_PD_TRACE_ENABLE) */
+
+        /* The deferred work of the optional modules, in slot order: a due EPR
+         * keepalive takes the stack before the queued commands, PPS requests
+         * and discovery requests, and coalesced events are delivered last. */
+        for (slot = (uint8_t)CY_PDSTACK_SCHED_HOOK_EPR_KA; slot < (uint8_t)CY_PDSTACK_SCHED_HOOK_COUNT; slot++)
+        {
+            if (gl_schedHook[slot] != NULL)
+            {
+                (void)gl_schedHook[slot](ptrPdStackContext);
+            }
+        }
+    }
+
+    if (ptrTaskRun != NULL)
+    {
+        *ptrTaskRun = (pend != 0u);
+    }
+
+    return stat;
+}
+
+/* Urgency class of the pending work of a port, lower is served first: a
+ * latched VBus fault comes before everything else, received messages,
+ * serviced interrupts and due EPR keepalives carry the protocol deadlines
+ * (GoodCRC, tSenderResponse, tSinkEPRKeepAlive), state machine work comes
+ * next and ports which are only in a transient state come last. */
+static uint8_t sched_urgency(uint32_t pend)
+{
+    uint8_t urgency;
+
+    if ((pend & CY_PDSTACK_PEND_FAULT) != 0u)
+    {
+        urgency = 0u;
+    }
+    else if ((pend & (CY_PDSTACK_PEND_HW_INTR | CY_PDSTACK_PEND_RX_EVT | CY_PDSTACK_PEND_EPR_KA)) != 0u)
+    {
+        urgency = 1u;
+    }
+    else if ((pend & (CY_PDSTACK_PEND_TIMER | CY_PDSTACK_PEND_PE_EVT |
+                    CY_PDSTACK_PEND_DPM_CMD | CY_PDSTACK_PEND_APP)) != 0u)
+    {
+        urgency = 2u;
+    }
+    else
+    {
+        urgency = 3u;
+    }
+
+    return urgency;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_TaskPending(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        bool *ptrTaskRun)
+{
+    uint32_t intrState;
+    uint32_t posted;
+
+    if (!sched_ctx_valid(ptrPdStackContext))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    /* Consume the posted flags first so that anything posted while the task is
+     * running is seen on the next call. */
+    intrState = Cy_SysLib_EnterCriticalSection();
+    posted = gl_pendWork[ptrPdStackContext->port];
+    gl_pendWork[ptrPdStackContext->port] = 0u;
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return sched_run(ptrPdStackContext, posted, sched_observed_work(ptrPdStackContext), ptrTaskRun);
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_TaskAll(
+        cy_stc_pdstack_context_t * const ptrPdStackContext[],
+        uint8_t numPorts,
+        bool *ptrTaskRun)
+{
+    cy_en_pdstack_status_t stat = CY_PDSTACK_STAT_SUCCESS;
+    cy_en_pdstack_status_t portStat;
+    uint32_t posted[CY_PD_MAX_NO_OF_PORTS];
+    uint32_t observed[CY_PD_MAX_NO_OF_PORTS];
+    uint32_t deadline[CY_PD_MAX_NO_OF_PORTS];
+    uint8_t urgency[CY_PD_MAX_NO_OF_PORTS];
+    uint8_t order[CY_PD_MAX_NO_OF_PORTS];
+    uint8_t runCount = 0u;
+    uint32_t intrState;
+    uint8_t i;
+    uint8_t j;
+
+    if ((ptrPdStackContext == NULL) || (numPorts == 0u) || (numPorts > CY_PD_MAX_NO_OF_PORTS))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    for (i = 0u; i < numPorts; i++)
+    {
+        if (!sched_ctx_valid(ptrPdStackContext[i]))
+        {
+            return CY_PDSTACK_STAT_BAD_PARAM;
+        }
+    }
+
+    /* Consume the posted flags of all ports in one critical section. */
+    intrState = Cy_SysLib_EnterCriticalSection();
+    for (i = 0u; i < numPorts; i++)
+    {
+        posted[i] = gl_pendWork[ptrPdStackContext[i]->port];
+        gl_pendWork[ptrPdStackContext[i]->port] = 0u;
+    }
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    /* Collect the ports with work, ordered by urgency class and then by the
+     * earliest running protocol timer. Idle ports are not visited again. */
+    for (i = 0u; i < numPorts; i++)
+    {
+        observed[i] = sched_observed_work(ptrPdStackContext[i]);
+        if ((posted[i] | observed[i]) == 0u)
+        {
+            continue;
+        }
+
+        urgency[i]  = sched_urgency(posted[i] | observed[i]);
+        deadline[i] = sched_port_deadline(ptrPdStackContext[i]);
+
+        j = runCount;
+        while ((j > 0u) && ((urgency[order[j - 1u]] > urgency[i]) ||
+                    ((urgency[order[j - 1u]] == urgency[i]) && (deadline[order[j - 1u]] > deadline[i]))))
+        {
+            order[j] = order[j - 1u];
+            j--;
+        }
+        order[j] = i;
+        runCount++;
+    }
+
+    for (j = 0u; j < runCount; j++)
+    {
+        i = order[j];
+        portStat = sched_run(ptrPdStackContext[i], posted[i], observed[i], NULL);
+        if (portStat != CY_PDSTACK_STAT_SUCCESS)
+        {
+            stat = portStat;
+        }
+    }
+
+    if (ptrTaskRun != NULL)
+    {
+        *ptrTaskRun = (runCount != 0u);
+    }
+
+    return stat;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_GetNextWakeup(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        uint32_t *ptrWakeupMs)
+{
+    uint32_t pend = 0u;
+
+    if ((!sched_ctx_valid(ptrPdStackContext)) || (ptrWakeupMs == NULL) ||
+            (ptrPdStackContext->ptrTimerContext == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    (void)Cy_PdStack_Dpm_GetPendingWork(ptrPdStackContext, &pend);
+    if (pend != 0u)
+    {
+        *ptrWakeupMs = 0u;
+        return CY_PDSTACK_STAT_SUCCESS;
+    }
+
+    *ptrWakeupMs = sched_port_deadline(ptrPdStackContext);
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_GetSleepBudget(
+        cy_stc_pdstack_context_t * const ptrPdStackContext[],
+        uint8_t numPorts,
+        uint32_t *ptrBudgetMs)
+{
+    uint32_t budget = CY_PDSTACK_WAKEUP_NONE;
+    uint32_t portWakeup;
+    uint8_t i;
+
+    if ((ptrPdStackContext == NULL) || (numPorts == 0u) || (ptrBudgetMs == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    /* A port which does not allow sleep reports pending work, which makes its
+     * wakeup time zero. */
+    for (i = 0u; i < numPorts; i++)
+    {
+        if (Cy_PdStack_Dpm_GetNextWakeup(ptrPdStackContext[i], &portWakeup) != CY_PDSTACK_STAT_SUCCESS)
+        {
+            return CY_PDSTACK_STAT_BAD_PARAM;
+        }
+
+        if (portWakeup < budget)
+        {
+            budget = portWakeup;
+        }
+
+        if (budget == 0u)
+        {
+            break;
+        }
+    }
+
+    *ptrBudgetMs = budget;
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+/* Checks the port list of an RTOS task, so that only the stack itself can
+ * fail a pass once the list has been accepted. */
+static bool sched_rtos_ports_valid(cy_stc_pdstack_context_t * const ptrPdStackContext[], uint8_t numPorts)
+{
+    uint8_t i;
+
+    if ((ptrPdStackContext == NULL) || (numPorts == 0u) || (numPorts > CY_PD_MAX_NO_OF_PORTS))
+    {
+        return false;
+    }
+
+    for (i = 0u; i < numPorts; i++)
+    {
+        if ((!sched_ctx_valid(ptrPdStackContext[i])) || (ptrPdStackContext[i]->ptrTimerContext == NULL))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_RtosTaskRun(
+        cy_stc_pdstack_context_t * const ptrPdStackContext[],
+        uint8_t numPorts,
+        uint32_t *ptrWaitMs)
+{
+    cy_en_pdstack_status_t stat;
+    cy_en_pdstack_status_t budgetStat;
+
+    if ((!sched_rtos_ports_valid(ptrPdStackContext, numPorts)) || (ptrWaitMs == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    stat = Cy_PdStack_Dpm_TaskAll(ptrPdStackContext, numPorts, NULL);
+
+    /* Deadlines are evaluated after all ports have run, so that work raised on
+     * one port by the task of another port is not missed. The wait time is
+     * reported even if the stack task of a port has failed. */
+    budgetStat = Cy_PdStack_Dpm_GetSleepBudget(ptrPdStackContext, numPorts, ptrWaitMs);
+
+    return (stat != CY_PDSTACK_STAT_SUCCESS) ? stat : budgetStat;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_RtosTaskLoop(
+        cy_stc_pdstack_context_t * const ptrPdStackContext[],
+        uint8_t numPorts)
+{
+    cy_stc_pdstack_rtos_context_t *ptrRtos;
+    uint32_t waitMs;
+    uint32_t waitTick;
+
+    if (!sched_rtos_ports_valid(ptrPdStackContext, numPorts))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    ptrRtos = ptrPdStackContext[0]->ptrRtosContext;
+    if ((ptrRtos == NULL) || (ptrRtos->dpm_rtos_evt_take == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    for (;;)
+    {
+        /* The port list has been checked, so a failing pass is an error of
+         * the stack on one of the ports. It is handled by the stack, so the
+         * task keeps running. */
+        (void)Cy_PdStack_Dpm_RtosTaskRun(ptrPdStackContext, numPorts, &waitMs);
+
+        if (waitMs == CY_PDSTACK_WAKEUP_NONE)
+        {
+            waitTick = CY_PDSTACK_RTOS_WAIT_FOREVER;
+        }
+        else
+        {
+            waitTick = (uint32_t)CY_PDSTACK_RTOS_MS_TO_TICKS(waitMs);
+        }
+
+        /* Both a timeout and a posted event lead to the next pass. */
+        (void)ptrRtos->dpm_rtos_evt_take(ptrPdStackContext[0], waitTick);
+    }
+}
+
+#endif /* (CY_PD_EVENT_DRIVEN_TASK_ENABLE) */
+
+/* [] END OF FILE */
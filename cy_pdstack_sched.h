@@ -0,0 +1,390 @@
+/***************************************************************************//**
+* \file cy_pdstack_sched.h
+* \version 4.0
+*
+* Header file of the event-driven task scheduling support of the PDStack
+* middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_SCHED_H)
+#define CY_PDSTACK_SCHED_H
+
+#include "cy_pdstack_common.h"
+
+/*******************************************************************************
+*                              Type definitions
+*******************************************************************************/
+
+/**
+* \addtogroup group_pdstack_macros
+* \{
+*/
+
+/** Pending work: USB PD block interrupt has been serviced for the port. */
+#define CY_PDSTACK_PEND_HW_INTR                 (1UL << 0u)
+
+/** Pending work: a PDStack soft timer belonging to the port has expired. */
+#define CY_PDSTACK_PEND_TIMER                   (1UL << 1u)
+
+/** Pending work: a DPM PD or Type-C command is registered with the stack. */
+#define CY_PDSTACK_PEND_DPM_CMD                 (1UL << 2u)
+
+/** Pending work: policy engine events are waiting to be processed. */
+#define CY_PDSTACK_PEND_PE_EVT                  (1UL << 3u)
+
+/** Pending work: protocol layer receive event is waiting to be processed. */
+#define CY_PDSTACK_PEND_RX_EVT                  (1UL << 4u)
+
+/** Pending work: Type-C or PD state machine is in a transient (non-idle) state. */
+#define CY_PDSTACK_PEND_BUSY                    (1UL << 5u)
+
+/** Pending work: the application has requested a task run. */
+#define CY_PDSTACK_PEND_APP                     (1UL << 6u)
+
+/** Pending work: an EPR keepalive is due. Served with the protocol deadlines,
+ * right after latched faults. */
+#define CY_PDSTACK_PEND_EPR_KA                  (1UL << 7u)
+
+/** Pending work: a VBus fault has been latched. Served ahead of all other
+ * work, and its response is handed to the stack before the stack task runs. */
+#define CY_PDSTACK_PEND_FAULT                   (1UL << 8u)
+
+/** Value reported by Cy_PdStack_Dpm_GetNextWakeup when no deadline is armed. */
+#define CY_PDSTACK_WAKEUP_NONE                  (0xFFFFFFFFUL)
+
+/**
+ * Converts a millisecond period into the tick count passed to the
+ * dpm_rtos_evt_take callback. The default assumes a 1 ms RTOS tick; the
+ * application can override this to match its RTOS configuration.
+ */
+#ifndef CY_PDSTACK_RTOS_MS_TO_TICKS
+#define CY_PDSTACK_RTOS_MS_TO_TICKS(ms)         (ms)
+#endif /* CY_PDSTACK_RTOS_MS_TO_TICKS */
+
+/** Tick count passed to dpm_rtos_evt_take to block without a timeout. */
+#ifndef CY_PDSTACK_RTOS_WAIT_FOREVER
+#define CY_PDSTACK_RTOS_WAIT_FOREVER            (0xFFFFFFFFUL)
+#endif /* CY_PDSTACK_RTOS_WAIT_FOREVER */
+
+/** \} group_pdstack_macros */
+
+/**
+* \addtogroup group_pdstack_enums
+* \{
+*/
+
+/**
+ * @typedef cy_en_pdstack_sched_hook_t
+ * @brief Deferred work slots run after the stack task, in this order. The
+ * fault slot is run before the stack task.
+ */
+typedef enum
+{
+    CY_PDSTACK_SCHED_HOOK_FAULT = 0,            /**< Fast VBus fault response, before the stack task. */
+    CY_PDSTACK_SCHED_HOOK_EPR_KA,               /**< EPR keepalive offload, ahead of any other deferred work. */
+    CY_PDSTACK_SCHED_HOOK_CMD_QUEUE,            /**< Queued DPM PD commands. */
+    CY_PDSTACK_SCHED_HOOK_PPS_STREAM,           /**< PPS/AVS streaming requests. */
+    CY_PDSTACK_SCHED_HOOK_VDM_DISC,             /**< SOP discovery engine. */
+    CY_PDSTACK_SCHED_HOOK_EVT_COALESCE,         /**< Coalesced event delivery, after all work of the pass. */
+    CY_PDSTACK_SCHED_HOOK_COUNT                 /**< Number of slots. */
+} cy_en_pdstack_sched_hook_t;
+
+/** \} group_pdstack_enums */
+
+/**
+* \addtogroup group_pdstack_data_structures
+* \{
+*/
+
+/**
+ * @brief Deferred work function run by the scheduler after the stack task of
+ * a port.
+ */
+typedef cy_en_pdstack_status_t (*cy_pdstack_sched_hook_t)(cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/** \} group_pdstack_data_structures */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_SetSchedHook
+****************************************************************************//**
+*
+* Installs the deferred work function of a slot. The optional modules install
+* their task when they are first used, so that the scheduler does not refer
+* to them and the linker drops the modules which the application never calls
+* when unused sections are removed.
+*
+* \param slot
+* Slot to be set.
+*
+* \param hook
+* Deferred work function, or NULL to clear the slot.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_SetSchedHook(
+        cy_en_pdstack_sched_hook_t slot,
+        cy_pdstack_sched_hook_t hook);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_SetPendingWork
+****************************************************************************//**
+*
+* Marks work as pending for the specified port. This function is safe to be
+* called from interrupt context. The application is expected to call it from
+* the USB PD interrupt handler (CY_PDSTACK_PEND_HW_INTR) and from the soft timer
+* interrupt handler (CY_PDSTACK_PEND_TIMER) after the corresponding driver
+* handler has been invoked.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param pendMask
+* Bitmask of CY_PDSTACK_PEND_* flags to be set.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_SetPendingWork(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        uint32_t pendMask);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_GetPendingWork
+****************************************************************************//**
+*
+* Reports the pending-work bitmap of the specified port without clearing it.
+* The bitmap combines the flags posted through Cy_PdStack_Dpm_SetPendingWork
+* with the work observed in the stack state (policy engine events, protocol
+* layer receive events, registered DPM commands and busy state machines).
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrPendMask
+* Output parameter contains the CY_PDSTACK_PEND_* bitmap. Zero indicates that
+* Cy_PdStack_Dpm_Task does not need to run for this port.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_GetPendingWork(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        uint32_t *ptrPendMask);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_TaskPending
+****************************************************************************//**
+*
+* Runs the Type-C manager and PD policy manager tasks for the specified port
+* only if work is pending. The posted pending-work flags are consumed by this
+* call. When no work is pending, the function returns immediately.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrTaskRun
+* Output parameter contains true if Cy_PdStack_Dpm_Task was invoked,
+* otherwise false. Can be NULL if the information is not required.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_TaskPending(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        bool *ptrTaskRun);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_TaskAll
+****************************************************************************//**
+*
+* Runs one scheduling pass over several ports. The posted work flags of all
+* ports are consumed in a single critical section and only the ports with work
+* are run, most urgent first:
+* - ports with a latched VBus fault (Cy_PdStack_Dpm_FaultIsr);
+* - ports with a serviced USB PD interrupt, a received message or a due EPR
+*   keepalive, since these carry the GoodCRC, sender response and
+*   tSinkEPRKeepAlive deadlines;
+* - ports with expired timers, policy engine events, DPM commands or
+*   application requests;
+* - ports which are only in a transient state.
+*
+* Within the same class, the port with the earliest running protocol timer is
+* run first. Work raised on a port while the other ports are being run is
+* handled by the next call.
+*
+* \param ptrPdStackContext
+* Array of PDStack library context pointers, at most CY_PD_MAX_NO_OF_PORTS.
+*
+* \param numPorts
+* Number of entries in the ptrPdStackContext array.
+*
+* \param ptrTaskRun
+* Optional output parameter, set to true if Cy_PdStack_Dpm_Task was run on
+* at least one port. Can be NULL.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+* Otherwise the last failing status of Cy_PdStack_Dpm_Task; all ports with
+* work are still run.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_TaskAll(
+        cy_stc_pdstack_context_t * const ptrPdStackContext[],
+        uint8_t numPorts,
+        bool *ptrTaskRun);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_GetNextWakeup
+****************************************************************************//**
+*
+* Reports the time until the next PDStack deadline on the specified port.
+* The deadline is derived from the soft timers owned by the stack for the port
+* (PD, Type-C and fault handling timers). If work is already pending, zero is
+* reported.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrWakeupMs
+* Output parameter contains the time in ms until the next deadline, or
+* CY_PDSTACK_WAKEUP_NONE if no stack timer is running for the port.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_GetNextWakeup(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        uint32_t *ptrWakeupMs);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_GetSleepBudget
+****************************************************************************//**
+*
+* Reports how long the device can stay in deep sleep without missing a
+* PDStack deadline on any of the specified ports. Zero is reported if any
+* port does not allow sleep (Cy_PdStack_Dpm_IsSleepAllowed) or has pending
+* work; otherwise the earliest soft timer deadline across the ports is
+* reported, which includes the EPR keepalive and PPS timers.
+*
+* CC and VBus events wake the device through their interrupts and therefore
+* do not limit the budget. Deadlines of application timers, including those
+* of a Cy_PdStack_TimerWheel, are not covered and must be combined by the
+* caller, along with the wakeup latency of the selected sleep state.
+*
+* A tickless idle loop is expected to call this after
+* Cy_PdStack_Dpm_PrepareDeepSleep has succeeded on all ports.
+*
+* \param ptrPdStackContext
+* Array of PDStack library context pointers.
+*
+* \param numPorts
+* Number of entries in the ptrPdStackContext array.
+*
+* \param ptrBudgetMs
+* Output parameter contains the sleep budget in ms, or
+* CY_PDSTACK_WAKEUP_NONE if only an interrupt can raise new work.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_GetSleepBudget(
+        cy_stc_pdstack_context_t * const ptrPdStackContext[],
+        uint8_t numPorts,
+        uint32_t *ptrBudgetMs);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_RtosTaskRun
+****************************************************************************//**
+*
+* Runs one pass of the RTOS execution mode: Cy_PdStack_Dpm_TaskAll is called
+* for the ports handled by the task and the time until the earliest deadline
+* across these ports is reported.
+*
+* \param ptrPdStackContext
+* Array of PDStack library context pointers handled by the calling task.
+*
+* \param numPorts
+* Number of entries in the ptrPdStackContext array.
+*
+* \param ptrWaitMs
+* Output parameter contains the time in ms for which the task can block, or
+* CY_PDSTACK_WAKEUP_NONE if no deadline is armed on any of the ports. Also
+* updated when the stack task of a port fails.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid: a NULL
+* array or context, a port count of zero or above CY_PD_MAX_NO_OF_PORTS, or a
+* port without timer context.
+* Otherwise the status of Cy_PdStack_Dpm_TaskAll, which is passed through
+* unchanged.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_RtosTaskRun(
+        cy_stc_pdstack_context_t * const ptrPdStackContext[],
+        uint8_t numPorts,
+        uint32_t *ptrWaitMs);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_RtosTaskLoop
+****************************************************************************//**
+*
+* Entry point of a PDStack RTOS task. The function runs the stack for the
+* specified ports and then blocks in the dpm_rtos_evt_take callback until the
+* next soft timer deadline or until an event is posted from an interrupt
+* (Cy_PdStack_Dpm_SetPendingWork or the stack itself calling dpm_rtos_evt_give).
+*
+* The application can create one task per port by passing a single context,
+* or one task for all ports by passing all contexts. In the latter case, all
+* contexts must be registered (Cy_PdStack_Dpm_Rtos_Init) with RTOS callbacks
+* that signal the same event object, because the task blocks on the event of
+* the first context.
+*
+* This function does not return unless the parameters are invalid. Errors
+* reported by the stack task of a port do not end the loop.
+*
+* \param ptrPdStackContext
+* Array of PDStack library context pointers handled by the calling task.
+*
+* \param numPorts
+* Number of entries in the ptrPdStackContext array.
+*
+* \return
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_RtosTaskLoop(
+        cy_stc_pdstack_context_t * const ptrPdStackContext[],
+        uint8_t numPorts);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_SCHED_H */
+
+/* [] END OF FILE */
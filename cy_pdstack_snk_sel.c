@@ -0,0 +1,498 @@
+/***************************************************************************//**
+* \file cy_pdstack_snk_sel.c
+* \version 4.0
+*
+* Source file of the sink contract selection engine of the PDStack
+* middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_snk_sel.h"
+
+#if ((CY_PD_SNK_SEL_ENABLE) && (CY_PDSTACK_CFG_SNK_SUPP))
+
+/* Extracts a bit field from a data object. */
+#define SEL_FIELD(val, pos, mask)       (((val) >> (pos)) & (mask))
+
+/* PDO type (B31:30) and APDO subtype (B29:28). */
+#define SEL_PDO_FIXED                   (0u)
+#define SEL_PDO_BATTERY                 (1u)
+#define SEL_PDO_VARIABLE                (2u)
+#define SEL_PDO_APDO                    (3u)
+#define SEL_APDO_PPS                    (0u)
+#define SEL_APDO_EPR_AVS                (1u)
+
+/* Decoded PDO kinds. */
+#define SEL_KIND_NONE                   (0u)
+#define SEL_KIND_FIXED                  (1u)
+#define SEL_KIND_VARIABLE               (2u)
+#define SEL_KIND_BATTERY                (3u)
+#define SEL_KIND_PPS                    (4u)
+#define SEL_KIND_AVS                    (5u)
+
+/* First object position of the EPR PDOs in an EPR source capabilities message. */
+#define SEL_EPR_FIRST_POS               (8u)
+
+/* RDO flag fields. */
+#define SEL_RDO_POS_POS                 (28u)
+#define SEL_RDO_GIVE_BACK               (1UL << 27u)
+#define SEL_RDO_CAP_MISMATCH            (1UL << 26u)
+#define SEL_RDO_USB_COMM                (1UL << 25u)
+#define SEL_RDO_NO_USB_SUSP             (1UL << 24u)
+#define SEL_RDO_EPR_CAPABLE             (1UL << 22u)
+
+#define SEL_SNK_PDO_MAX                 (CY_PD_MAX_NO_OF_PDO + CY_PD_MAX_NO_OF_EPR_PDO)
+
+/* PDO decoded to common units: mV, 10 mA and 250 mW. For EPR AVS, opValue
+ * holds the PDP in W. */
+typedef struct
+{
+    uint16_t    minMv;
+    uint16_t    maxMv;
+    uint16_t    opValue;
+    uint16_t    maxMin;
+    uint8_t     kind;
+    bool        giveBack;
+} sel_pdo_t;
+
+typedef struct
+{
+    sel_pdo_t                   snk[SEL_SNK_PDO_MAX];
+    uint8_t                     snkCount;
+    cy_en_pdstack_pdo_sel_alg_t selAlg;
+    bool                        ready;
+    app_resp_t                  resp;
+} sel_port_t;
+
+/* Operating point of a source PDO against a sink PDO. */
+typedef struct
+{
+    uint16_t    mv;
+    uint16_t    cur;            /* 10 mA units, or 250 mW units for battery. */
+    bool        mismatch;
+} sel_cand_t;
+
+static sel_port_t gl_snkSel[CY_PD_MAX_NO_OF_PORTS];
+
+static sel_port_t *sel_get(const cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    if ((ptrPdStackContext == NULL) || (ptrPdStackContext->port >= CY_PD_MAX_NO_OF_PORTS))
+    {
+        return NULL;
+    }
+
+    return &gl_snkSel[ptrPdStackContext->port];
+}
+
+static void sel_decode(uint32_t val, sel_pdo_t *ptrPdo)
+{
+    ptrPdo->kind = SEL_KIND_NONE;
+
+    switch (SEL_FIELD(val, 30u, 0x3u))
+    {
+        case SEL_PDO_FIXED:
+            ptrPdo->kind    = SEL_KIND_FIXED;
+            ptrPdo->minMv   = (uint16_t)(SEL_FIELD(val, 10u, 0x3FFu) * 50u);
+            ptrPdo->maxMv   = ptrPdo->minMv;
+            ptrPdo->opValue = (uint16_t)SEL_FIELD(val, 0u, 0x3FFu);
+            break;
+
+        case SEL_PDO_VARIABLE:
+        case SEL_PDO_BATTERY:
+            ptrPdo->kind    = (SEL_FIELD(val, 30u, 0x3u) == SEL_PDO_VARIABLE) ? SEL_KIND_VARIABLE : SEL_KIND_BATTERY;
+            ptrPdo->maxMv   = (uint16_t)(SEL_FIELD(val, 20u, 0x3FFu) * 50u);
+            ptrPdo->minMv   = (uint16_t)(SEL_FIELD(val, 10u, 0x3FFu) * 50u);
+            ptrPdo->opValue = (uint16_t)SEL_FIELD(val, 0u, 0x3FFu);
+            break;
+
+        default:
+            if (SEL_FIELD(val, 28u, 0x3u) == SEL_APDO_PPS)
+            {
+                ptrPdo->kind    = SEL_KIND_PPS;
+                ptrPdo->maxMv   = (uint16_t)(SEL_FIELD(val, 17u, 0xFFu) * 100u);
+                ptrPdo->minMv   = (uint16_t)(SEL_FIELD(val, 8u, 0xFFu) * 100u);
+                ptrPdo->opValue = (uint16_t)(SEL_FIELD(val, 0u, 0x7Fu) * 5u);
+            }
+            else if (SEL_FIELD(val, 28u, 0x3u) == SEL_APDO_EPR_AVS)
+            {
+                ptrPdo->kind    = SEL_KIND_AVS;
+                ptrPdo->maxMv   = (uint16_t)(SEL_FIELD(val, 17u, 0x1FFu) * 100u);
+                ptrPdo->minMv   = (uint16_t)(SEL_FIELD(val, 8u, 0xFFu) * 100u);
+                ptrPdo->opValue = (uint16_t)SEL_FIELD(val, 0u, 0xFFu);
+            }
+            else
+            {
+                /* SPR AVS has no sink APDO to be matched against. */
+            }
+            break;
+    }
+}
+
+static void sel_add_snk(sel_port_t *ptrSel, uint32_t pdo, uint16_t maxMin)
+{
+    sel_pdo_t *ptrPdo = &ptrSel->snk[ptrSel->snkCount];
+
+    sel_decode(pdo, ptrPdo);
+    if (ptrPdo->kind != SEL_KIND_NONE)
+    {
+        ptrPdo->maxMin   = (uint16_t)(maxMin & CY_PD_SNK_MIN_MAX_MASK);
+        ptrPdo->giveBack = ((maxMin & CY_PD_GIVE_BACK_MASK) != 0u);
+        ptrSel->snkCount++;
+    }
+}
+
+static uint32_t sel_score(cy_en_pdstack_pdo_sel_alg_t selAlg, const sel_cand_t *ptrCand, uint8_t kind)
+{
+    uint32_t power = (kind == SEL_KIND_BATTERY) ? ((uint32_t)ptrCand->cur * 25000u) :
+        ((uint32_t)ptrCand->mv * ptrCand->cur);
+
+    switch (selAlg)
+    {
+        case CY_PDSTACK_HIGHEST_CURRENT:
+            return (kind == SEL_KIND_BATTERY) ? (power / ptrCand->mv) : ptrCand->cur;
+
+        case CY_PDSTACK_HIGHEST_VOLTAGE:
+            return ptrCand->mv;
+
+        default:
+            return power;
+    }
+}
+
+/* Works out the operating point of a source PDO against one sink PDO. Returns
+ * false if the two are not compatible. */
+static bool sel_match(const sel_pdo_t *ptrSrc, const sel_pdo_t *ptrSnk, sel_cand_t *ptrCand)
+{
+    uint16_t lo;
+    uint16_t hi;
+
+    ptrCand->mismatch = false;
+
+    if (ptrSrc->minMv == 0u)
+    {
+        return false;
+    }
+
+    switch (ptrSrc->kind)
+    {
+        case SEL_KIND_FIXED:
+            if ((ptrSnk->kind == SEL_KIND_PPS) || (ptrSnk->kind == SEL_KIND_AVS) ||
+                    (ptrSrc->minMv < ptrSnk->minMv) || (ptrSrc->minMv > ptrSnk->maxMv))
+            {
+                return false;
+            }
+            ptrCand->mv = ptrSrc->minMv;
+            if (ptrSnk->kind == SEL_KIND_BATTERY)
+            {
+                /* Sink power demand expressed as current at this voltage. */
+                ptrCand->cur = (uint16_t)(((uint32_t)ptrSnk->opValue * 25000u) / ptrSrc->minMv);
+            }
+            else
+            {
+                ptrCand->cur = ptrSnk->opValue;
+            }
+            break;
+
+        case SEL_KIND_VARIABLE:
+        case SEL_KIND_BATTERY:
+            if ((ptrSnk->kind != ptrSrc->kind) ||
+                    (ptrSrc->minMv < ptrSnk->minMv) || (ptrSrc->maxMv > ptrSnk->maxMv))
+            {
+                return false;
+            }
+            ptrCand->mv  = ptrSrc->minMv;
+            ptrCand->cur = ptrSnk->opValue;
+            break;
+
+        case SEL_KIND_PPS:
+        case SEL_KIND_AVS:
+            if (ptrSnk->kind != ptrSrc->kind)
+            {
+                return false;
+            }
+            lo = (ptrSrc->minMv > ptrSnk->minMv) ? ptrSrc->minMv : ptrSnk->minMv;
+            hi = (ptrSrc->maxMv < ptrSnk->maxMv) ? ptrSrc->maxMv : ptrSnk->maxMv;
+            if ((lo > hi) || (hi == 0u))
+            {
+                return false;
+            }
+            ptrCand->mv = hi;
+            if (ptrSrc->kind == SEL_KIND_PPS)
+            {
+                ptrCand->cur = (ptrSrc->opValue < ptrSnk->opValue) ? ptrSrc->opValue : ptrSnk->opValue;
+            }
+            else
+            {
+                /* Current from the lower of the two PDPs at the chosen voltage. */
+                lo = (ptrSrc->opValue < ptrSnk->opValue) ? ptrSrc->opValue : ptrSnk->opValue;
+                ptrCand->cur = (uint16_t)(((uint32_t)lo * 100000u) / hi);
+            }
+            return true;
+
+        default:
+            return false;
+    }
+
+    /* Fixed supply limits: request what the source has, flag the shortfall. */
+    if (ptrCand->cur > ptrSrc->opValue)
+    {
+        ptrCand->cur      = ptrSrc->opValue;
+        ptrCand->mismatch = true;
+    }
+
+    return true;
+}
+
+static uint32_t sel_build_rdo(const cy_stc_pdstack_context_t *ptrPdStackContext, uint8_t pos,
+        const sel_pdo_t *ptrSrc, const sel_pdo_t *ptrSnk, const sel_cand_t *ptrCand)
+{
+    uint32_t rdo = ((uint32_t)pos << SEL_RDO_POS_POS);
+    uint32_t maxMin;
+
+    if (ptrPdStackContext->dpmStat.snkUsbCommEn != 0u)
+    {
+        rdo |= SEL_RDO_USB_COMM;
+    }
+    if (ptrPdStackContext->dpmStat.snkUsbSuspEn == 0u)
+    {
+        rdo |= SEL_RDO_NO_USB_SUSP;
+    }
+    if (CY_PDSTACK_CFG_EPR_SNK_EN(ptrPdStackContext))
+    {
+        rdo |= SEL_RDO_EPR_CAPABLE;
+    }
+    if (ptrCand->mismatch)
+    {
+        rdo |= SEL_RDO_CAP_MISMATCH;
+    }
+
+    switch (ptrSrc->kind)
+    {
+        case SEL_KIND_PPS:
+            /* Output voltage in 20 mV units, operating current in 50 mA units. */
+            rdo |= ((((uint32_t)ptrCand->mv / 20u) & 0xFFFu) << 9u) | (((uint32_t)ptrCand->cur / 5u) & 0x7Fu);
+            break;
+
+        case SEL_KIND_AVS:
+            /* Output voltage in 25 mV units with the two LSBs zero (100 mV steps). */
+            rdo |= ((((uint32_t)ptrCand->mv / 25u) & 0xFFCu) << 9u) | (((uint32_t)ptrCand->cur / 5u) & 0x7Fu);
+            break;
+
+        default:
+            maxMin = (ptrSnk->maxMin != 0u) ? ptrSnk->maxMin : ptrCand->cur;
+            if (ptrSnk->giveBack)
+            {
+                rdo |= SEL_RDO_GIVE_BACK;
+            }
+            else if (maxMin < ptrCand->cur)
+            {
+                maxMin = ptrCand->cur;
+            }
+            else
+            {
+                /* Max current already covers the operating current. */
+            }
+
+            if ((ptrSrc->kind == SEL_KIND_BATTERY) || (ptrSnk->kind != SEL_KIND_BATTERY))
+            {
+                rdo |= (((uint32_t)ptrCand->cur & 0x3FFu) << 10u) | (maxMin & 0x3FFu);
+            }
+            else
+            {
+                /* Battery sink on a fixed supply: both fields in current units. */
+                rdo |= (((uint32_t)ptrCand->cur & 0x3FFu) << 10u) | ((uint32_t)ptrCand->cur & 0x3FFu);
+            }
+            break;
+    }
+
+    return rdo;
+}
+
+/* RDO for vSafe5V on PDO1, against the first sink PDO of the stack
+ * configuration. Does not depend on the sink table, so that a request can
+ * always be made. */
+static uint32_t sel_safe_rdo(const cy_stc_pdstack_context_t *ptrPdStackContext,
+        const cy_stc_pdstack_pd_packet_t *srcCap, bool mismatch)
+{
+    sel_pdo_t src = {5000u, 5000u, 0u, 0u, SEL_KIND_FIXED, false};
+    sel_pdo_t snk;
+    sel_cand_t cand;
+    uint16_t maxMin = ptrPdStackContext->dpmStat.snkMaxMin[0];
+
+    if ((srcCap != NULL) && (srcCap->len != 0u))
+    {
+        sel_decode(srcCap->dat[0].val, &src);
+        src.kind = SEL_KIND_FIXED;
+    }
+
+    sel_decode(ptrPdStackContext->dpmStat.snkPdo[0].val, &snk);
+    snk.maxMin   = (uint16_t)(maxMin & CY_PD_SNK_MIN_MAX_MASK);
+    snk.giveBack = ((maxMin & CY_PD_GIVE_BACK_MASK) != 0u);
+
+    cand.mv       = 5000u;
+    cand.cur      = snk.opValue;
+    cand.mismatch = mismatch;
+    if (cand.cur > src.opValue)
+    {
+        cand.cur      = src.opValue;
+        cand.mismatch = true;
+    }
+
+    return sel_build_rdo(ptrPdStackContext, 1u, &src, &snk, &cand);
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_SnkSelUpdate(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_pdo_sel_alg_t selAlg)
+{
+    sel_port_t *ptrSel = sel_get(ptrPdStackContext);
+    const cy_stc_pdstack_dpm_status_t *ptrDpm;
+    const cy_stc_pdstack_epr_t *ptrEpr;
+    uint8_t i;
+
+    if (ptrSel == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    ptrDpm = &ptrPdStackContext->dpmStat;
+    ptrEpr = &ptrPdStackContext->dpmExtStat.epr;
+
+    ptrSel->ready    = false;
+    ptrSel->snkCount = 0u;
+    ptrSel->selAlg   = selAlg;
+
+    for (i = 0u; (i < ptrDpm->snkPdoCount) && (i < CY_PD_MAX_NO_OF_PDO); i++)
+    {
+        if ((ptrDpm->snkPdoMask & (1u << i)) != 0u)
+        {
+            sel_add_snk(ptrSel, ptrDpm->snkPdo[i].val, ptrDpm->snkMaxMin[i]);
+        }
+    }
+
+    if (CY_PDSTACK_CFG_EPR_SNK_EN(ptrPdStackContext))
+    {
+        for (i = 0u; (i < ptrEpr->snkPdoCount) && (i < CY_PD_MAX_NO_OF_EPR_PDO); i++)
+        {
+            if ((ptrEpr->snkPdoMask & (1u << i)) != 0u)
+            {
+                sel_add_snk(ptrSel, ptrEpr->snkPdo[i].val, ptrEpr->snkMaxMin[i]);
+            }
+        }
+    }
+
+    ptrSel->ready = true;
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_SnkSelGetRdo(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        const cy_stc_pdstack_pd_packet_t *srcCap,
+        cy_pd_pd_do_t *ptrRdo)
+{
+    sel_port_t *ptrSel = sel_get(ptrPdStackContext);
+    sel_pdo_t src;
+    sel_pdo_t bestSrc = {0u, 0u, 0u, 0u, SEL_KIND_NONE, false};
+    sel_cand_t cand;
+    sel_cand_t best = {0u, 0u, false};
+    uint32_t score;
+    uint32_t bestScore = 0u;
+    uint8_t bestPos = 0u;
+    uint8_t bestSnk = 0u;
+    uint8_t count;
+    uint8_t i;
+    uint8_t j;
+
+    if ((ptrSel == NULL) || (srcCap == NULL) || (ptrRdo == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    if ((!ptrSel->ready) || (ptrSel->snkCount == 0u))
+    {
+        return CY_PDSTACK_STAT_NOT_READY;
+    }
+
+    count = srcCap->len;
+    if (count > (CY_PD_MAX_NO_OF_PDO + CY_PD_MAX_NO_OF_EPR_PDO))
+    {
+        count = CY_PD_MAX_NO_OF_PDO + CY_PD_MAX_NO_OF_EPR_PDO;
+    }
+
+    for (i = 0u; i < count; i++)
+    {
+        if ((srcCap->dat[i].val == 0u) ||
+                (((i + 1u) >= SEL_EPR_FIRST_POS) && (!CY_PDSTACK_CFG_EPR_ACTIVE(ptrPdStackContext))))
+        {
+            continue;
+        }
+
+        sel_decode(srcCap->dat[i].val, &src);
+
+        /* Work per source PDO is bounded by the sink table size. */
+        for (j = 0u; j < ptrSel->snkCount; j++)
+        {
+            if (sel_match(&src, &ptrSel->snk[j], &cand))
+            {
+                score = sel_score(ptrSel->selAlg, &cand, src.kind);
+
+                /* A mismatched contract only wins when nothing else fits. */
+                if ((bestPos == 0u) || (best.mismatch && (!cand.mismatch)) ||
+                        ((best.mismatch == cand.mismatch) && (score > bestScore)))
+                {
+                    best      = cand;
+                    bestSrc   = src;
+                    bestScore = score;
+                    bestPos   = i + 1u;
+                    bestSnk   = j;
+                }
+            }
+        }
+    }
+
+    if (bestPos == 0u)
+    {
+        /* Nothing fits: request vSafe5V and report the mismatch. */
+        ptrRdo->val = sel_safe_rdo(ptrPdStackContext, srcCap, true);
+    }
+    else
+    {
+        ptrRdo->val = sel_build_rdo(ptrPdStackContext, bestPos, &bestSrc, &ptrSel->snk[bestSnk], &best);
+    }
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+void Cy_PdStack_Dpm_SnkSelEvalSrcCap(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        const cy_stc_pdstack_pd_packet_t *srcCap,
+        cy_pdstack_app_resp_cbk_t app_resp_handler)
+{
+    sel_port_t *ptrSel = sel_get(ptrPdStackContext);
+
+    if ((ptrSel == NULL) || (app_resp_handler == NULL))
+    {
+        return;
+    }
+
+    /* The stack waits for the response, so one is always given. */
+    if (Cy_PdStack_Dpm_SnkSelGetRdo(ptrPdStackContext, srcCap, &ptrSel->resp.respDo) != CY_PDSTACK_STAT_SUCCESS)
+    {
+        ptrSel->resp.respDo.val = sel_safe_rdo(ptrPdStackContext, srcCap, false);
+    }
+
+    ptrSel->resp.reqStatus = CY_PDSTACK_REQ_ACCEPT;
+    app_resp_handler(ptrPdStackContext, &ptrSel->resp);
+}
+
+#endif /* ((CY_PD_SNK_SEL_ENABLE) && (CY_PDSTACK_CFG_SNK_SUPP)) */
+
+/* [] END OF FILE */
@@ -0,0 +1,119 @@
+/***************************************************************************//**
+* \file cy_pdstack_snk_sel.h
+* \version 4.0
+*
+* Header file of the sink contract selection engine of the PDStack
+* middleware. The engine evaluates received source capabilities against a
+* table precomputed from the sink capabilities and produces the RDO without
+* involving the application.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_SNK_SEL_H)
+#define CY_PDSTACK_SNK_SEL_H
+
+#include "cy_pdstack_common.h"
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_SnkSelUpdate
+****************************************************************************//**
+*
+* Rebuilds the decoded sink capability table of the port from the active sink
+* PDOs, their max/min current settings and masks, including the EPR sink
+* capabilities. Must be called after Cy_PdStack_Dpm_Init and after every
+* change of the sink capabilities (Cy_PdStack_Dpm_UpdateSnkCap,
+* Cy_PdStack_Dpm_UpdateSnkCapMask, Cy_PdStack_Dpm_UpdateSnkMaxMin and their
+* EPR counterparts).
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param selAlg
+* Contract selection algorithm. Unlike the fixed PDO only application
+* examples, all PDO types take part in the selection.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_SnkSelUpdate(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_pdo_sel_alg_t selAlg);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_SnkSelGetRdo
+****************************************************************************//**
+*
+* Selects the best source PDO and builds the corresponding RDO. Fixed,
+* variable, battery, PPS and EPR AVS PDOs are considered; EPR PDOs only while
+* the port is in EPR mode. The work per source PDO is bounded by the number of
+* sink PDOs. If no PDO matches, vSafe5V is requested with the capability
+* mismatch flag set.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param srcCap
+* Pointer to the received source capabilities.
+*
+* \param ptrRdo
+* Output parameter which receives the RDO.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_NOT_READY if Cy_PdStack_Dpm_SnkSelUpdate has not been called.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_SnkSelGetRdo(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        const cy_stc_pdstack_pd_packet_t *srcCap,
+        cy_pd_pd_do_t *ptrRdo);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_SnkSelEvalSrcCap
+****************************************************************************//**
+*
+* Implementation of the eval_src_cap application callback based on
+* Cy_PdStack_Dpm_SnkSelGetRdo. Can be placed directly in the
+* cy_stc_pdstack_app_cbk_t structure, so that the RDO is reported in the
+* context of the stack without passing through application code.
+*
+* A response is always given. If Cy_PdStack_Dpm_SnkSelGetRdo fails, because
+* Cy_PdStack_Dpm_SnkSelUpdate has not been called, the sink table is empty or
+* the source capabilities are missing, vSafe5V is requested on PDO1 against
+* the first sink PDO of the port. The capability mismatch flag is set if PDO1
+* cannot supply the operating current of that sink PDO.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param srcCap
+* Pointer to the received source capabilities.
+*
+* \param app_resp_handler
+* Callback through which the RDO is reported.
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_SnkSelEvalSrcCap(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        const cy_stc_pdstack_pd_packet_t *srcCap,
+        cy_pdstack_app_resp_cbk_t app_resp_handler);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_SNK_SEL_H */
+
+/* [] END OF FILE */
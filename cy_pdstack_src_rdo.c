@@ -0,0 +1,286 @@
+/***************************************************************************//**
+* \file cy_pdstack_src_rdo.c
+* \version 4.0
+*
+* Source file of the cached source RDO validation of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_src_rdo.h"
+
+#if ((CY_PD_SRC_RDO_CACHE_ENABLE) && (CY_PDSTACK_CFG_SRC_SUPP))
+
+#define RDO_FIELD(val, pos, mask)       (((val) >> (pos)) & (mask))
+
+/* Decoded PDO kinds. */
+#define RDO_KIND_NONE                   (0u)
+#define RDO_KIND_FIXED                  (1u)
+#define RDO_KIND_VARIABLE               (2u)
+#define RDO_KIND_BATTERY                (3u)
+#define RDO_KIND_PPS                    (4u)
+#define RDO_KIND_EPR_AVS                (5u)
+#define RDO_KIND_SPR_AVS                (6u)
+
+/* Object positions: 1-7 SPR, 8-13 EPR. */
+#define RDO_EPR_FIRST_POS               (8u)
+#define RDO_POS_MAX                     (CY_PD_MAX_NO_OF_PDO + CY_PD_MAX_NO_OF_EPR_PDO)
+
+/* SPR AVS voltage range and the boundary between its two current limits. */
+#define RDO_SPR_AVS_MIN_MV              (9000u)
+#define RDO_SPR_AVS_MID_MV              (15000u)
+#define RDO_SPR_AVS_MAX_MV              (20000u)
+
+#define RDO_CAP_MISMATCH                (1UL << 26u)
+
+/* Decoded source PDO. Limits are in mV, 10 mA, 250 mW or W (EPR AVS PDP). For
+ * SPR AVS, limitA applies up to 15 V and limitB above. */
+typedef struct
+{
+    uint16_t    minMv;
+    uint16_t    maxMv;
+    uint16_t    limitA;
+    uint16_t    limitB;
+    uint8_t     kind;
+} rdo_pdo_t;
+
+typedef struct
+{
+    rdo_pdo_t   pdo[RDO_POS_MAX];       /* Indexed by object position - 1. */
+    uint8_t     sprCount;
+    uint8_t     eprCount;
+    bool        eprActive;
+    bool        valid;
+    app_resp_t  resp;
+} rdo_cache_t;
+
+static rdo_cache_t gl_srcRdo[CY_PD_MAX_NO_OF_PORTS];
+
+static rdo_cache_t *rdo_get(const cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    if ((ptrPdStackContext == NULL) || (ptrPdStackContext->port >= CY_PD_MAX_NO_OF_PORTS))
+    {
+        return NULL;
+    }
+
+    return &gl_srcRdo[ptrPdStackContext->port];
+}
+
+static void rdo_decode(uint32_t val, rdo_pdo_t *ptrPdo)
+{
+    ptrPdo->kind   = RDO_KIND_NONE;
+    ptrPdo->limitB = 0u;
+
+    switch (RDO_FIELD(val, 30u, 0x3u))
+    {
+        case 0u:
+            ptrPdo->kind   = RDO_KIND_FIXED;
+            ptrPdo->minMv  = (uint16_t)(RDO_FIELD(val, 10u, 0x3FFu) * 50u);
+            ptrPdo->maxMv  = ptrPdo->minMv;
+            ptrPdo->limitA = (uint16_t)RDO_FIELD(val, 0u, 0x3FFu);
+            break;
+
+        case 1u:
+        case 2u:
+            ptrPdo->kind   = (RDO_FIELD(val, 30u, 0x3u) == 1u) ? RDO_KIND_BATTERY : RDO_KIND_VARIABLE;
+            ptrPdo->maxMv  = (uint16_t)(RDO_FIELD(val, 20u, 0x3FFu) * 50u);
+            ptrPdo->minMv  = (uint16_t)(RDO_FIELD(val, 10u, 0x3FFu) * 50u);
+            ptrPdo->limitA = (uint16_t)RDO_FIELD(val, 0u, 0x3FFu);
+            break;
+
+        default:
+            switch (RDO_FIELD(val, 28u, 0x3u))
+            {
+                case 0u:
+                    ptrPdo->kind   = RDO_KIND_PPS;
+                    ptrPdo->maxMv  = (uint16_t)(RDO_FIELD(val, 17u, 0xFFu) * 100u);
+                    ptrPdo->minMv  = (uint16_t)(RDO_FIELD(val, 8u, 0xFFu) * 100u);
+                    ptrPdo->limitA = (uint16_t)(RDO_FIELD(val, 0u, 0x7Fu) * 5u);
+                    break;
+
+                case 1u:
+                    ptrPdo->kind   = RDO_KIND_EPR_AVS;
+                    ptrPdo->maxMv  = (uint16_t)(RDO_FIELD(val, 17u, 0x1FFu) * 100u);
+                    ptrPdo->minMv  = (uint16_t)(RDO_FIELD(val, 8u, 0xFFu) * 100u);
+                    ptrPdo->limitA = (uint16_t)RDO_FIELD(val, 0u, 0xFFu);
+                    break;
+
+                case 2u:
+                    ptrPdo->kind   = RDO_KIND_SPR_AVS;
+                    ptrPdo->minMv  = RDO_SPR_AVS_MIN_MV;
+                    ptrPdo->maxMv  = (RDO_FIELD(val, 0u, 0x3FFu) != 0u) ? RDO_SPR_AVS_MAX_MV : RDO_SPR_AVS_MID_MV;
+                    ptrPdo->limitA = (uint16_t)RDO_FIELD(val, 10u, 0x3FFu);
+                    ptrPdo->limitB = (uint16_t)RDO_FIELD(val, 0u, 0x3FFu);
+                    break;
+
+                default:
+                    /* Reserved APDO type. */
+                    break;
+            }
+            break;
+    }
+}
+
+/* Decodes the capabilities last sent by the stack. Masks have already been
+ * applied to curSrcPdo, so positions map directly onto it. */
+static void rdo_rebuild(const cy_stc_pdstack_context_t *ptrPdStackContext, rdo_cache_t *ptrCache)
+{
+    const cy_stc_pdstack_dpm_status_t *ptrDpm = &ptrPdStackContext->dpmStat;
+    const cy_stc_pdstack_dpm_ext_status_t *ptrExt = &ptrPdStackContext->dpmExtStat;
+    uint8_t i;
+
+    ptrCache->eprActive = CY_PDSTACK_CFG_EPR_ACTIVE(ptrPdStackContext);
+    ptrCache->sprCount  = (ptrDpm->curSrcPdocount < CY_PD_MAX_NO_OF_PDO) ? ptrDpm->curSrcPdocount : CY_PD_MAX_NO_OF_PDO;
+    ptrCache->eprCount  = 0u;
+    if (ptrCache->eprActive)
+    {
+        ptrCache->eprCount = (ptrExt->curEprSrcPdoCount < CY_PD_MAX_NO_OF_EPR_PDO) ?
+            ptrExt->curEprSrcPdoCount : CY_PD_MAX_NO_OF_EPR_PDO;
+    }
+
+    for (i = 0u; i < RDO_POS_MAX; i++)
+    {
+        if ((i < ptrCache->sprCount) ||
+                ((i >= CY_PD_MAX_NO_OF_PDO) && ((uint8_t)(i - CY_PD_MAX_NO_OF_PDO) < ptrCache->eprCount)))
+        {
+            rdo_decode(ptrDpm->curSrcPdo[i].val, &ptrCache->pdo[i]);
+        }
+        else
+        {
+            ptrCache->pdo[i].kind = RDO_KIND_NONE;
+        }
+    }
+
+    ptrCache->valid = true;
+}
+
+static bool rdo_check(const rdo_pdo_t *ptrPdo, uint32_t rdo)
+{
+    bool mismatch = ((rdo & RDO_CAP_MISMATCH) != 0u);
+    uint32_t op;
+    uint32_t max;
+    uint32_t mv;
+
+    switch (ptrPdo->kind)
+    {
+        case RDO_KIND_FIXED:
+        case RDO_KIND_VARIABLE:
+        case RDO_KIND_BATTERY:
+            /* Operating and max/min value in the units of the PDO limit. */
+            op  = RDO_FIELD(rdo, 10u, 0x3FFu);
+            max = RDO_FIELD(rdo, 0u, 0x3FFu);
+            return ((op <= ptrPdo->limitA) && (mismatch || (max <= ptrPdo->limitA)));
+
+        case RDO_KIND_PPS:
+            mv = RDO_FIELD(rdo, 9u, 0xFFFu) * 20u;
+            op = RDO_FIELD(rdo, 0u, 0x7Fu) * 5u;
+            return ((mv >= ptrPdo->minMv) && (mv <= ptrPdo->maxMv) && (op <= ptrPdo->limitA));
+
+        case RDO_KIND_EPR_AVS:
+        case RDO_KIND_SPR_AVS:
+            /* Output voltage in 25 mV units, only 100 mV steps allowed. */
+            if ((RDO_FIELD(rdo, 9u, 0x3u)) != 0u)
+            {
+                return false;
+            }
+            mv = RDO_FIELD(rdo, 9u, 0xFFFu) * 25u;
+            op = RDO_FIELD(rdo, 0u, 0x7Fu) * 5u;
+            if ((mv < ptrPdo->minMv) || (mv > ptrPdo->maxMv))
+            {
+                return false;
+            }
+            if (ptrPdo->kind == RDO_KIND_EPR_AVS)
+            {
+                /* mV * 10 mA against the PDP in W. */
+                return ((mv * op) <= ((uint32_t)ptrPdo->limitA * 100000u));
+            }
+            return (op <= ((mv <= RDO_SPR_AVS_MID_MV) ? ptrPdo->limitA : ptrPdo->limitB));
+
+        default:
+            return false;
+    }
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_SrcRdoCacheInvalidate(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    rdo_cache_t *ptrCache = rdo_get(ptrPdStackContext);
+
+    if (ptrCache == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    ptrCache->valid = false;
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_SrcRdoValidate(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_pd_pd_do_t rdo,
+        cy_en_pdstack_app_req_status_t *ptrStatus)
+{
+    rdo_cache_t *ptrCache = rdo_get(ptrPdStackContext);
+    uint8_t pos;
+
+    if ((ptrCache == NULL) || (ptrStatus == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    /* EPR mode changes and the resulting new capabilities are picked up
+     * without an explicit invalidation. */
+    if ((!ptrCache->valid) || (ptrCache->eprActive != CY_PDSTACK_CFG_EPR_ACTIVE(ptrPdStackContext)) ||
+            (ptrCache->sprCount != ptrPdStackContext->dpmStat.curSrcPdocount) ||
+            (ptrCache->eprActive && (ptrCache->eprCount != ptrPdStackContext->dpmExtStat.curEprSrcPdoCount)))
+    {
+        rdo_rebuild(ptrPdStackContext, ptrCache);
+    }
+
+    *ptrStatus = CY_PDSTACK_REQ_REJECT;
+
+    pos = (uint8_t)RDO_FIELD(rdo.val, 28u, 0xFu);
+    if ((pos == 0u) || (pos > RDO_POS_MAX) || ((pos >= RDO_EPR_FIRST_POS) && (!ptrCache->eprActive)))
+    {
+        return CY_PDSTACK_STAT_SUCCESS;
+    }
+
+    if (rdo_check(&ptrCache->pdo[pos - 1u], rdo.val))
+    {
+        *ptrStatus = CY_PDSTACK_REQ_ACCEPT;
+    }
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+void Cy_PdStack_Dpm_SrcRdoEvalRdo(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_pd_pd_do_t rdo,
+        cy_pdstack_app_resp_cbk_t app_resp_handler)
+{
+    rdo_cache_t *ptrCache = rdo_get(ptrPdStackContext);
+    cy_en_pdstack_app_req_status_t status;
+
+    if ((ptrCache == NULL) || (app_resp_handler == NULL))
+    {
+        return;
+    }
+
+    if (Cy_PdStack_Dpm_SrcRdoValidate(ptrPdStackContext, rdo, &status) == CY_PDSTACK_STAT_SUCCESS)
+    {
+        ptrCache->resp.respDo    = rdo;
+        ptrCache->resp.reqStatus = status;
+        app_resp_handler(ptrPdStackContext, &ptrCache->resp);
+    }
+}
+
+#endif /* ((CY_PD_SRC_RDO_CACHE_ENABLE) && (CY_PDSTACK_CFG_SRC_SUPP)) */
+
+/* [] END OF FILE */
@@ -0,0 +1,104 @@
+/***************************************************************************//**
+* \file cy_pdstack_src_rdo.h
+* \version 4.0
+*
+* Header file of the cached source RDO validation of the PDStack middleware.
+* The advertised source capabilities are decoded once, so that a received
+* request can be validated with a single table lookup.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_SRC_RDO_H)
+#define CY_PDSTACK_SRC_RDO_H
+
+#include "cy_pdstack_common.h"
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_SrcRdoCacheInvalidate
+****************************************************************************//**
+*
+* Marks the decoded source capability view of the port as stale. Must be
+* called after Cy_PdStack_Dpm_UpdateSrcCap, Cy_PdStack_Dpm_UpdateSrcCapMask,
+* Cy_PdStack_Dpm_UpdateEprSrcCap and Cy_PdStack_Dpm_UpdateEprSrcCapMask. The
+* view is rebuilt by the next validation; EPR mode entry and exit are detected
+* without an explicit call.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_SrcRdoCacheInvalidate(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_SrcRdoValidate
+****************************************************************************//**
+*
+* Validates a received RDO against the decoded view of the source capabilities
+* last advertised on the port. Fixed, variable, battery, PPS, SPR AVS and EPR
+* AVS requests are supported.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param rdo
+* Received RDO.
+*
+* \param ptrStatus
+* Output parameter which receives CY_PDSTACK_REQ_ACCEPT if the request can be
+* met and CY_PDSTACK_REQ_REJECT otherwise.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_SrcRdoValidate(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_pd_pd_do_t rdo,
+        cy_en_pdstack_app_req_status_t *ptrStatus);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_SrcRdoEvalRdo
+****************************************************************************//**
+*
+* Implementation of the eval_rdo application callback based on
+* Cy_PdStack_Dpm_SrcRdoValidate. Can be placed directly in the
+* cy_stc_pdstack_app_cbk_t structure, so that Accept or Reject is decided in
+* the context of the stack without passing through application code.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param rdo
+* Received RDO.
+*
+* \param app_resp_handler
+* Callback through which the decision is reported.
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_SrcRdoEvalRdo(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_pd_pd_do_t rdo,
+        cy_pdstack_app_resp_cbk_t app_resp_handler);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_SRC_RDO_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,102 @@
+/***************************************************************************//**
+* \file cy_pdstack_static_cfg.c
+* \version 4.0
+*
+* Source file of the compile-time port configuration of the PDStack
+* middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include "cy_pdstack_common.h"
+
+#if (CY_PD_STATIC_CFG_ENABLE)
+
+#if (!(CY_PD_STATIC_CFG_PPS))
+
+/* Size of the SPR PDO lists of the port configuration. */
+#define STATIC_CFG_PDO_MAX              (7u)
+
+/* PDO type field: 3 = augmented PDO. */
+#define STATIC_CFG_PDO_TYPE_POS         (30u)
+#define STATIC_CFG_PDO_TYPE_APDO        (3u)
+
+static bool static_cfg_has_apdo(const uint32_t *ptrPdo, uint8_t count)
+{
+    uint8_t i;
+
+    for (i = 0u; (i < count) && (i < STATIC_CFG_PDO_MAX); i++)
+    {
+        if ((ptrPdo[i] >> STATIC_CFG_PDO_TYPE_POS) == STATIC_CFG_PDO_TYPE_APDO)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#endif /* (!(CY_PD_STATIC_CFG_PPS)) */
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_StaticCfgCheck(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    const cy_stc_pdstack_port_cfg_t *ptrCfg;
+
+    if ((ptrPdStackContext == NULL) || (ptrPdStackContext->port >= CY_PD_MAX_NO_OF_PORTS) ||
+            (ptrPdStackContext->ptrPortCfg == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    ptrCfg = ptrPdStackContext->ptrPortCfg;
+
+    if (ptrCfg->portRole != (uint8_t)CY_PD_STATIC_CFG_PORT_ROLE)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+#if (!(CY_PD_STATIC_CFG_REV3))
+    /* Extended capabilities, Get_Revision and Get_Source_Info only exist in
+     * USB PD Revision 3.x. */
+    if ((ptrCfg->scedbEn != 0u) || (ptrCfg->skedbEn != 0u) ||
+            (ptrCfg->pdRevision != 0u) || (ptrCfg->srcInfo != 0u))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+#endif /* (!(CY_PD_STATIC_CFG_REV3)) */
+
+#if (!(CY_PD_STATIC_CFG_PPS))
+    if ((static_cfg_has_apdo(ptrCfg->srcPdo, ptrCfg->srcPdoCount)) ||
+            (static_cfg_has_apdo(ptrCfg->snkPdo, ptrCfg->snkPdoCount)))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+#endif /* (!(CY_PD_STATIC_CFG_PPS)) */
+
+#if (!(CY_PD_STATIC_CFG_EPR))
+    if ((ptrCfg->eprSrcPdoCount != 0u) || (ptrCfg->eprSnkPdoCount != 0u))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+#endif /* (!(CY_PD_STATIC_CFG_EPR)) */
+
+#if (!(CY_PD_STATIC_CFG_FRS))
+    if (ptrCfg->frsConfig != 0u)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+#endif /* (!(CY_PD_STATIC_CFG_FRS)) */
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+#endif /* (CY_PD_STATIC_CFG_ENABLE) */
+
+/* [] END OF FILE */
@@ -0,0 +1,172 @@
+/***************************************************************************//**
+* \file cy_pdstack_static_cfg.h
+* \version 4.0
+*
+* Header file of the compile-time port configuration of the PDStack
+* middleware. When CY_PD_STATIC_CFG_ENABLE is set, the port role and the
+* optional PD features are fixed at build time, so that the source delivered
+* with the middleware is compiled for the selected configuration only.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_STATIC_CFG_H)
+#define CY_PDSTACK_STATIC_CFG_H
+
+/*******************************************************************************
+*                        Configuration inputs
+*******************************************************************************/
+
+#if (CY_PD_STATIC_CFG_ENABLE)
+
+#if CY_USE_CONFIG_TABLE
+#error "CY_PD_STATIC_CFG_ENABLE cannot be used with CY_USE_CONFIG_TABLE."
+#endif /* CY_USE_CONFIG_TABLE */
+
+/* Port role, encoded as the portRole member of cy_stc_pdstack_port_cfg_t:
+ * 0 = Sink, 1 = Source, 2 = Dual-role. */
+#ifndef CY_PD_STATIC_CFG_PORT_ROLE
+#error "CY_PD_STATIC_CFG_PORT_ROLE must be defined when CY_PD_STATIC_CFG_ENABLE is set."
+#endif /* CY_PD_STATIC_CFG_PORT_ROLE */
+
+/* USB PD Revision 3.x messaging in use. */
+#ifndef CY_PD_STATIC_CFG_REV3
+#define CY_PD_STATIC_CFG_REV3            (1u)
+#endif /* CY_PD_STATIC_CFG_REV3 */
+
+/* EPR operation in use. */
+#ifndef CY_PD_STATIC_CFG_EPR
+#define CY_PD_STATIC_CFG_EPR             (0u)
+#endif /* CY_PD_STATIC_CFG_EPR */
+
+/* PPS and AVS operation in use. */
+#ifndef CY_PD_STATIC_CFG_PPS
+#define CY_PD_STATIC_CFG_PPS             (0u)
+#endif /* CY_PD_STATIC_CFG_PPS */
+
+/* Fast role swap in use. */
+#ifndef CY_PD_STATIC_CFG_FRS
+#define CY_PD_STATIC_CFG_FRS             (0u)
+#endif /* CY_PD_STATIC_CFG_FRS */
+
+#if (CY_PD_STATIC_CFG_PORT_ROLE > 2)
+#error "CY_PD_STATIC_CFG_PORT_ROLE must be 0 (Sink), 1 (Source) or 2 (Dual-role)."
+#endif /* (CY_PD_STATIC_CFG_PORT_ROLE > 2) */
+
+#if ((CY_PD_SINK_ONLY) && (CY_PD_STATIC_CFG_PORT_ROLE != 0))
+#error "The sink-only library supports CY_PD_STATIC_CFG_PORT_ROLE = 0 (Sink) only."
+#endif /* ((CY_PD_SINK_ONLY) && (CY_PD_STATIC_CFG_PORT_ROLE != 0)) */
+
+#if ((CY_PD_SOURCE_ONLY) && (CY_PD_STATIC_CFG_PORT_ROLE != 1))
+#error "The source-only library supports CY_PD_STATIC_CFG_PORT_ROLE = 1 (Source) only."
+#endif /* ((CY_PD_SOURCE_ONLY) && (CY_PD_STATIC_CFG_PORT_ROLE != 1)) */
+
+#if ((!(CY_PD_STATIC_CFG_REV3)) && ((CY_PD_STATIC_CFG_EPR) || (CY_PD_STATIC_CFG_PPS) || (CY_PD_STATIC_CFG_FRS)))
+#error "EPR, PPS and FRS require CY_PD_STATIC_CFG_REV3."
+#endif /* ((!(CY_PD_STATIC_CFG_REV3)) && ((CY_PD_STATIC_CFG_EPR) || (CY_PD_STATIC_CFG_PPS) || (CY_PD_STATIC_CFG_FRS))) */
+
+#if ((CY_PD_STATIC_CFG_FRS) && (CY_PD_STATIC_CFG_PORT_ROLE != 2))
+#error "FRS requires CY_PD_STATIC_CFG_PORT_ROLE = 2 (Dual-role)."
+#endif /* ((CY_PD_STATIC_CFG_FRS) && (CY_PD_STATIC_CFG_PORT_ROLE != 2)) */
+
+#endif /* (CY_PD_STATIC_CFG_ENABLE) */
+
+/*******************************************************************************
+*                        Derived feature macros
+*******************************************************************************/
+
+/**
+* \addtogroup group_pdstack_macros
+* \{
+*/
+
+#if ((!(CY_PD_SOURCE_ONLY)) && ((!(CY_PD_STATIC_CFG_ENABLE)) || (CY_PD_STATIC_CFG_PORT_ROLE != 1)))
+/** Sink operation can occur on the ports. Usable in preprocessor conditions. */
+#define CY_PDSTACK_CFG_SNK_SUPP          (1u)
+#else
+#define CY_PDSTACK_CFG_SNK_SUPP          (0u)
+#endif /* Sink operation */
+
+#if ((!(CY_PD_SINK_ONLY)) && ((!(CY_PD_STATIC_CFG_ENABLE)) || (CY_PD_STATIC_CFG_PORT_ROLE != 0)))
+/** Source operation can occur on the ports. Usable in preprocessor conditions. */
+#define CY_PDSTACK_CFG_SRC_SUPP          (1u)
+#else
+#define CY_PDSTACK_CFG_SRC_SUPP          (0u)
+#endif /* Source operation */
+
+#if ((!(CY_PD_STATIC_CFG_ENABLE)) || (CY_PD_STATIC_CFG_EPR))
+/** EPR operation can occur on the ports. Usable in preprocessor conditions. */
+#define CY_PDSTACK_CFG_EPR_SUPP          (1u)
+#else
+#define CY_PDSTACK_CFG_EPR_SUPP          (0u)
+#endif /* EPR operation */
+
+#if ((!(CY_PD_STATIC_CFG_ENABLE)) || (CY_PD_STATIC_CFG_PPS))
+/** PPS and AVS operation can occur on the ports. Usable in preprocessor conditions. */
+#define CY_PDSTACK_CFG_PPS_SUPP          (1u)
+#else
+#define CY_PDSTACK_CFG_PPS_SUPP          (0u)
+#endif /* PPS operation */
+
+#if ((!(CY_PD_STATIC_CFG_ENABLE)) || (CY_PD_STATIC_CFG_FRS))
+/** Fast role swap can occur on the ports. Usable in preprocessor conditions. */
+#define CY_PDSTACK_CFG_FRS_SUPP          (1u)
+#else
+#define CY_PDSTACK_CFG_FRS_SUPP          (0u)
+#endif /* FRS operation */
+
+/** Whether the port is in EPR mode. Constant false when EPR is configured out. */
+#define CY_PDSTACK_CFG_EPR_ACTIVE(context)                                      \
+    ((CY_PDSTACK_CFG_EPR_SUPP != 0u) && ((context)->dpmExtStat.eprActive))
+
+/** Whether EPR sink operation is enabled on the port. Constant false when EPR is
+ * configured out. */
+#define CY_PDSTACK_CFG_EPR_SNK_EN(context)                                      \
+    ((CY_PDSTACK_CFG_EPR_SUPP != 0u) && ((context)->dpmExtStat.epr.snkEnable != 0u))
+
+/** \} group_pdstack_macros */
+
+#if (CY_PD_STATIC_CFG_ENABLE)
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_StaticCfgCheck
+****************************************************************************//**
+*
+* Verifies that the runtime configuration of the port agrees with the
+* compile-time configuration. Branches removed at build time are not
+* reachable at runtime, so a port configuration which enables them must not
+* be used. Checked are the port role, EPR PDOs, FRS, augmented PDOs in the
+* SPR PDO lists when CY_PD_STATIC_CFG_PPS is not set, and the Revision 3.x
+* settings (extended capabilities, Get_Revision and Get_Source_Info responses)
+* when CY_PD_STATIC_CFG_REV3 is not set. Expected to be called once before
+* Cy_PdStack_Dpm_Start.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the configurations agree.
+* CY_PDSTACK_STAT_BAD_PARAM if the parameters are invalid or the runtime
+* configuration enables a role or feature which is configured out.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_StaticCfgCheck(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/** \} group_pdstack_functions */
+
+#endif /* (CY_PD_STATIC_CFG_ENABLE) */
+
+#endif /* CY_PDSTACK_STATIC_CFG_H */
+
+/* [] END OF FILE */
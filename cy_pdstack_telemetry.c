@@ -0,0 +1,292 @@
+/***************************************************************************//**
+* \file cy_pdstack_telemetry.c
+* \version 4.0
+*
+* Source file of the power telemetry ring of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "cy_syslib.h"
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_dpm.h"
+#include "cy_pdstack_telemetry.h"
+#include "cy_pdstack_perf.h"
+#if (CY_PD_TRACE_ENABLE)
+#include "cy_pdstack_trace.h"
+#endif /* (CY_PD_TRACE_ENABLE) */
+
+#if (CY_PD_TELEMETRY_ENABLE)
+
+#define TELEM_TIMER_ID(ptrPdStackContext)                                       \
+    ((cy_timer_id_t)(CY_PDSTACK_TELEMETRY_TIMER_BASE_ID + (ptrPdStackContext)->port))
+
+#define TELEM_MASK                      ((uint16_t)(CY_PD_TELEMETRY_DEPTH - 1u))
+
+/* Extracts a bit field from a data object. */
+#define TELEM_FIELD(val, pos, mask)     (((val) >> (pos)) & (mask))
+
+/* APDO type (B31:30) and subtype (B29:28). */
+#define TELEM_PDO_APDO                  (3u)
+#define TELEM_APDO_PPS                  (0u)
+
+typedef struct
+{
+    cy_stc_pdstack_telem_rec_t          rec[CY_PD_TELEMETRY_DEPTH];
+    cy_stc_pdstack_telem_status_t       stat;
+
+    /* Free-running indices; rdIdx is moved on when the ring is full. */
+    uint16_t                            wrIdx;
+    uint16_t                            rdIdx;
+} telem_port_t;
+
+static telem_port_t gl_telem[CY_PD_MAX_NO_OF_PORTS];
+
+static telem_port_t *telem_get(const cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    if ((ptrPdStackContext == NULL) || (ptrPdStackContext->port >= CY_PD_MAX_NO_OF_PORTS))
+    {
+        return NULL;
+    }
+
+    return &gl_telem[ptrPdStackContext->port];
+}
+
+/* Operating voltage requested on a PPS or AVS APDO; zero on fixed, battery and
+ * variable supplies. */
+static uint16_t telem_op_volt(const cy_stc_pdstack_context_t *ptrPdStackContext, bool source)
+{
+    uint32_t pdo = source ? ptrPdStackContext->dpmStat.srcSelPdo.val : ptrPdStackContext->dpmStat.snkSelPdo.val;
+    uint32_t rdo = source ? ptrPdStackContext->dpmStat.srcRdo.val : ptrPdStackContext->dpmStat.snkRdo.val;
+
+    if (TELEM_FIELD(pdo, 30u, 0x3u) != TELEM_PDO_APDO)
+    {
+        return 0u;
+    }
+
+    /* PPS requests in 20 mV steps, SPR and EPR AVS in 25 mV steps. */
+    return (uint16_t)(TELEM_FIELD(rdo, 9u, 0xFFFu) *
+            ((TELEM_FIELD(pdo, 28u, 0x3u) == TELEM_APDO_PPS) ? 20u : 25u));
+}
+
+/* Can be called from the soft timer callback. */
+static void telem_write(cy_stc_pdstack_context_t *ptrPdStackContext, telem_port_t *ptrTelem,
+        cy_en_pdstack_telem_type_t type)
+{
+    cy_stc_pdstack_telem_rec_t rec;
+    uint32_t intrState;
+    bool source = (ptrPdStackContext->dpmConfig.curPortRole == (uint8_t)CY_PD_PRT_ROLE_SOURCE);
+
+    /* Built outside the critical section; only the store is locked. */
+    (void)memset(&rec, 0, sizeof(rec));
+    rec.type   = (uint8_t)type;
+    rec.vbusMv = Cy_PdStack_Dpm_GetVbusVoltage(ptrPdStackContext);
+    if (source)
+    {
+        rec.flags |= CY_PDSTACK_TELEM_FLAG_SOURCE;
+    }
+    if ((type != CY_PDSTACK_TELEM_CONTRACT_END) && (ptrPdStackContext->dpmConfig.contractExist))
+    {
+        rec.flags   |= CY_PDSTACK_TELEM_FLAG_CONTRACT;
+        rec.contract = ptrPdStackContext->dpmStat.contract;
+        rec.opVolt   = telem_op_volt(ptrPdStackContext, source);
+        if (rec.opVolt != 0u)
+        {
+            rec.flags |= CY_PDSTACK_TELEM_FLAG_APDO;
+        }
+        if (CY_PDSTACK_CFG_EPR_ACTIVE(ptrPdStackContext))
+        {
+            rec.flags |= CY_PDSTACK_TELEM_FLAG_EPR;
+        }
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    if (ptrTelem->stat.active)
+    {
+        rec.time = CY_PDSTACK_GET_TIME_US();
+        if ((uint16_t)(ptrTelem->wrIdx - ptrTelem->rdIdx) >= (uint16_t)CY_PD_TELEMETRY_DEPTH)
+        {
+            ptrTelem->rdIdx++;
+            ptrTelem->stat.lostCount++;
+        }
+        ptrTelem->rec[ptrTelem->wrIdx & TELEM_MASK] = rec;
+        ptrTelem->wrIdx++;
+
+        if (type == CY_PDSTACK_TELEM_SAMPLE)
+        {
+            ptrTelem->stat.sampleCount++;
+        }
+        else
+        {
+            ptrTelem->stat.contractCount++;
+        }
+    }
+    Cy_SysLib_ExitCriticalSection(intrState);
+}
+
+static void telem_period_cbk(cy_timer_id_t id, void *callbackContext)
+{
+    cy_stc_pdstack_context_t *ptrPdStackContext = (cy_stc_pdstack_context_t *)callbackContext;
+    telem_port_t *ptrTelem = telem_get(ptrPdStackContext);
+
+    if ((ptrTelem == NULL) || (!ptrTelem->stat.active) || (ptrTelem->stat.periodMs == 0u))
+    {
+        return;
+    }
+
+#if (CY_PD_TRACE_ENABLE)
+    Cy_PdStack_Dpm_TraceWrite(ptrPdStackContext, CY_PDSTACK_TRACE_TIMER, 0u, (uint16_t)id);
+#endif /* (CY_PD_TRACE_ENABLE) */
+
+    /* Restart from the expiry, so that the rate does not depend on the time
+     * taken by the sample. */
+    (void)Cy_PdUtils_SwTimer_Start(ptrPdStackContext->ptrTimerContext, ptrPdStackContext,
+            id, ptrTelem->stat.periodMs, telem_period_cbk);
+
+    telem_write(ptrPdStackContext, ptrTelem, CY_PDSTACK_TELEM_SAMPLE);
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_TelemetryStart(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        uint16_t periodMs)
+{
+    telem_port_t *ptrTelem = telem_get(ptrPdStackContext);
+
+    if ((ptrTelem == NULL) || ((periodMs != 0u) && (ptrPdStackContext->ptrTimerContext == NULL)))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    /* Nothing writes to the ring once it is stopped, so it can be cleared
+     * without locking interrupts. */
+    (void)Cy_PdStack_Dpm_TelemetryStop(ptrPdStackContext);
+    (void)memset(ptrTelem, 0, sizeof(telem_port_t));
+    ptrTelem->stat.periodMs = periodMs;
+    ptrTelem->stat.active   = true;
+
+    if ((periodMs != 0u) &&
+            (!Cy_PdUtils_SwTimer_Start(ptrPdStackContext->ptrTimerContext, ptrPdStackContext,
+                                       TELEM_TIMER_ID(ptrPdStackContext), periodMs, telem_period_cbk)))
+    {
+        ptrTelem->stat.active = false;
+        return CY_PDSTACK_STAT_FAILURE;
+    }
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_TelemetryStop(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    telem_port_t *ptrTelem = telem_get(ptrPdStackContext);
+
+    if (ptrTelem == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    ptrTelem->stat.active = false;
+    if ((ptrTelem->stat.periodMs != 0u) && (ptrPdStackContext->ptrTimerContext != NULL))
+    {
+        Cy_PdUtils_SwTimer_Stop(ptrPdStackContext->ptrTimerContext, TELEM_TIMER_ID(ptrPdStackContext));
+    }
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+void Cy_PdStack_Dpm_TelemetryEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data)
+{
+    telem_port_t *ptrTelem = telem_get(ptrPdStackContext);
+
+    CY_UNUSED_PARAMETER(data);
+
+    if ((ptrTelem == NULL) || (!ptrTelem->stat.active))
+    {
+        return;
+    }
+
+    switch (evt)
+    {
+        case APP_EVT_PD_CONTRACT_NEGOTIATION_COMPLETE:
+            telem_write(ptrPdStackContext, ptrTelem, CY_PDSTACK_TELEM_CONTRACT);
+            break;
+
+        case APP_EVT_HARD_RESET_RCVD:
+        case APP_EVT_HARD_RESET_SENT:
+        case APP_EVT_DISCONNECT:
+        case APP_EVT_TYPE_C_ERROR_RECOVERY:
+            telem_write(ptrPdStackContext, ptrTelem, CY_PDSTACK_TELEM_CONTRACT_END);
+            break;
+
+        default:
+            /* Not recorded. */
+            break;
+    }
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_TelemetryDrain(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_telem_rec_t *ptrRec,
+        uint16_t maxCount,
+        uint16_t *ptrCount)
+{
+    telem_port_t *ptrTelem = telem_get(ptrPdStackContext);
+    uint32_t intrState;
+    uint16_t count = 0u;
+    bool empty = false;
+
+    if ((ptrTelem == NULL) || (ptrRec == NULL) || (ptrCount == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    while ((count < maxCount) && (!empty))
+    {
+        intrState = Cy_SysLib_EnterCriticalSection();
+        empty = (ptrTelem->rdIdx == ptrTelem->wrIdx);
+        if (!empty)
+        {
+            ptrRec[count] = ptrTelem->rec[ptrTelem->rdIdx & TELEM_MASK];
+            ptrTelem->rdIdx++;
+            count++;
+        }
+        Cy_SysLib_ExitCriticalSection(intrState);
+    }
+
+    *ptrCount = count;
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_TelemetryGetStatus(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_telem_status_t *ptrStatus)
+{
+    telem_port_t *ptrTelem = telem_get(ptrPdStackContext);
+    uint32_t intrState;
+
+    if ((ptrTelem == NULL) || (ptrStatus == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    ptrTelem->stat.pending = (uint16_t)(ptrTelem->wrIdx - ptrTelem->rdIdx);
+    *ptrStatus = ptrTelem->stat;
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+#endif /* (CY_PD_TELEMETRY_ENABLE) */
+
+/* [] END OF FILE */
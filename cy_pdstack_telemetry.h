@@ -0,0 +1,242 @@
+/***************************************************************************//**
+* \file cy_pdstack_telemetry.h
+* \version 4.0
+*
+* Header file of the power telemetry ring of the PDStack middleware. The VBus
+* voltage and the contract of each port are sampled at a fixed rate, and
+* every contract change is recorded, into a per-port ring of time-stamped
+* records which the application or the EC drains in bulk.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_TELEMETRY_H)
+#define CY_PDSTACK_TELEMETRY_H
+
+#include "cy_pdstack_common.h"
+
+#if ((CY_PD_TELEMETRY_DEPTH == 0u) || (CY_PD_TELEMETRY_DEPTH > 256u) || \
+     ((CY_PD_TELEMETRY_DEPTH & (CY_PD_TELEMETRY_DEPTH - 1u)) != 0u))
+#error "CY_PD_TELEMETRY_DEPTH must be a power of two in the range 1 to 256."
+#endif
+
+/**
+* \addtogroup group_pdstack_macros
+* \{
+*/
+
+#ifndef CY_PDSTACK_TELEMETRY_TIMER_BASE_ID
+/** Soft timer ID used for the sampling period on port 0. Port N uses this ID
+ * plus N. Can be overridden to move the timers within the application timer
+ * range. */
+#define CY_PDSTACK_TELEMETRY_TIMER_BASE_ID      (CY_PDUTILS_TIMER_APP_PORT0_START_ID + 0xD8u)
+#if (CY_PD_MAX_NO_OF_PORTS > 8u)
+#error "The default telemetry timer IDs overlap the EPR keepalive timer IDs beyond 8 ports; override CY_PDSTACK_TELEMETRY_TIMER_BASE_ID."
+#endif
+#endif /* CY_PDSTACK_TELEMETRY_TIMER_BASE_ID */
+
+/** Record flag: an explicit contract is in place. */
+#define CY_PDSTACK_TELEM_FLAG_CONTRACT          (0x01u)
+
+/** Record flag: the port is the power source. */
+#define CY_PDSTACK_TELEM_FLAG_SOURCE            (0x02u)
+
+/** Record flag: the port is in EPR mode. */
+#define CY_PDSTACK_TELEM_FLAG_EPR               (0x04u)
+
+/** Record flag: the contract is on a PPS or AVS APDO; opVolt holds the
+ * requested operating voltage. */
+#define CY_PDSTACK_TELEM_FLAG_APDO              (0x08u)
+
+/** \} group_pdstack_macros */
+
+/**
+* \addtogroup group_pdstack_enums
+* \{
+*/
+
+/**
+ * @typedef cy_en_pdstack_telem_type_t
+ * @brief Types of telemetry records.
+ */
+typedef enum
+{
+    CY_PDSTACK_TELEM_NONE = 0,          /**< 0x00: Unused record. */
+    CY_PDSTACK_TELEM_SAMPLE,            /**< 0x01: Periodic sample. */
+    CY_PDSTACK_TELEM_CONTRACT,          /**< 0x02: Contract negotiation completed, PPS/AVS requests included. */
+    CY_PDSTACK_TELEM_CONTRACT_END       /**< 0x03: Contract ended by a reset, a detach or error recovery. */
+} cy_en_pdstack_telem_type_t;
+
+/** \} group_pdstack_enums */
+
+/**
+* \addtogroup group_pdstack_data_structures
+* \{
+*/
+
+/**
+ * @brief Telemetry record. Sixteen bytes, little-endian on all supported
+ * devices. Voltages are in mV.
+ */
+typedef struct
+{
+    uint32_t                    time;       /**< Time stamp in us, zero unless CY_PD_PERF_GET_TIME_US is provided. */
+    uint8_t                     type;       /**< Record type, cy_en_pdstack_telem_type_t. */
+    uint8_t                     flags;      /**< CY_PDSTACK_TELEM_FLAG_* bits. */
+    uint16_t                    vbusMv;     /**< VBus voltage measured through Cy_PdStack_Dpm_GetVbusVoltage. */
+    cy_stc_pdstack_contract_t   contract;   /**< Contract at the time of the record, zero without a contract. */
+    uint16_t                    opVolt;     /**< Operating voltage requested on a PPS or AVS APDO, else zero. */
+} cy_stc_pdstack_telem_rec_t;
+
+/**
+ * @brief Telemetry status of a port.
+ */
+typedef struct
+{
+    bool        active;             /**< Records are being written. */
+    uint16_t    periodMs;           /**< Sampling period, zero if only contract changes are recorded. */
+    uint16_t    pending;            /**< Records waiting to be drained. */
+    uint32_t    sampleCount;        /**< Samples written. */
+    uint32_t    contractCount;      /**< Contract records written. */
+    uint32_t    lostCount;          /**< Oldest records overwritten before they were drained. */
+} cy_stc_pdstack_telem_status_t;
+
+/** \} group_pdstack_data_structures */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_TelemetryStart
+****************************************************************************//**
+*
+* Clears the telemetry ring of a port and starts recording. Samples are
+* written from the soft timer callback, so the vbus_get_value application
+* callback must be callable from that context. Contract records are written
+* by Cy_PdStack_Dpm_TelemetryEventHandler. When the ring is full, the oldest
+* record is overwritten and counted as lost.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param periodMs
+* Sampling period in ms, or zero to record the contract changes only.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+* CY_PDSTACK_STAT_FAILURE if the sampling timer could not be started.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_TelemetryStart(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        uint16_t periodMs);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_TelemetryStop
+****************************************************************************//**
+*
+* Stops recording on a port. The records which have not been drained yet are
+* kept.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_TelemetryStop(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_TelemetryEventHandler
+****************************************************************************//**
+*
+* Records completed contract negotiations and the end of the contract on
+* resets, detach and error recovery. To be called from the application event
+* handler.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param evt
+* Event ID.
+*
+* \param data
+* Event data.
+*
+* \return
+* None
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_TelemetryEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_TelemetryDrain
+****************************************************************************//**
+*
+* Moves the oldest records of a port into a buffer. Interrupts are only
+* locked while a single record is moved, so that a large drain does not delay
+* the stack.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrRec
+* Buffer which receives the records, oldest first.
+*
+* \param maxCount
+* Capacity of the buffer in records.
+*
+* \param ptrCount
+* Output parameter which receives the number of records moved.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_TelemetryDrain(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_telem_rec_t *ptrRec,
+        uint16_t maxCount,
+        uint16_t *ptrCount);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_TelemetryGetStatus
+****************************************************************************//**
+*
+* Reports the telemetry status of a port.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrStatus
+* Output parameter which receives the status.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_TelemetryGetStatus(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_telem_status_t *ptrStatus);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_TELEMETRY_H */
+
+/* [] END OF FILE */
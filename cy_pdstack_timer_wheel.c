@@ -0,0 +1,383 @@
+/***************************************************************************//**
+* \file cy_pdstack_timer_wheel.c
+* \version 4.0
+*
+* Source file of the hierarchical timer wheel of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include "cy_syslib.h"
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_timer_wheel.h"
+
+#if (CY_PD_TIMER_WHEEL_ENABLE)
+
+/* Number of tick bits resolved by each level. */
+#define TWHEEL_LEVEL_BITS               (5u)
+#define TWHEEL_SLOT_MASK                (CY_PDSTACK_TWHEEL_SLOTS - 1u)
+
+/* Ticks covered by all levels together. */
+#define TWHEEL_RANGE_BITS               (TWHEEL_LEVEL_BITS * CY_PDSTACK_TWHEEL_LEVELS)
+#define TWHEEL_RANGE_MASK               ((1u << TWHEEL_RANGE_BITS) - 1u)
+
+/* Slot encodings of the entries which are not in a level slot. */
+#define TWHEEL_SLOT_OVERFLOW            (0xFEu)
+#define TWHEEL_SLOT_IDLE                (0xFFu)
+
+static cy_stc_pdstack_twheel_timer_t **twheel_list(cy_stc_pdstack_twheel_t *ptrWheel, uint8_t slot)
+{
+    if (slot == TWHEEL_SLOT_OVERFLOW)
+    {
+        return &ptrWheel->overflow;
+    }
+
+    return &ptrWheel->slot[slot / CY_PDSTACK_TWHEEL_SLOTS][slot & TWHEEL_SLOT_MASK];
+}
+
+static uint8_t twheel_lowest_bit(uint32_t mask)
+{
+    uint8_t idx = 0u;
+
+    while ((mask & 1u) == 0u)
+    {
+        mask >>= 1u;
+        idx++;
+    }
+
+    return idx;
+}
+
+/* Must be called with interrupts disabled. */
+static void twheel_link(cy_stc_pdstack_twheel_t *ptrWheel, cy_stc_pdstack_twheel_timer_t *ptrTimer)
+{
+    cy_stc_pdstack_twheel_timer_t **head;
+    uint32_t diff = ptrTimer->expiry ^ ptrWheel->now;
+    uint8_t level;
+    uint8_t idx;
+
+    /* The entry goes to the level of the highest tick bit group in which the
+     * expiry differs from the current tick. All higher groups are equal, which
+     * puts the entry strictly ahead of the current slot of that level. */
+    if ((diff & ~TWHEEL_RANGE_MASK) != 0u)
+    {
+        ptrTimer->slot = TWHEEL_SLOT_OVERFLOW;
+    }
+    else
+    {
+        level = 0u;
+        while ((diff >> (TWHEEL_LEVEL_BITS * (level + 1u))) != 0u)
+        {
+            level++;
+        }
+
+        idx = (uint8_t)((ptrTimer->expiry >> (TWHEEL_LEVEL_BITS * level)) & TWHEEL_SLOT_MASK);
+        ptrWheel->occupied[level] |= (1u << idx);
+        ptrTimer->slot = (uint8_t)((level * CY_PDSTACK_TWHEEL_SLOTS) + idx);
+    }
+
+    head = twheel_list(ptrWheel, ptrTimer->slot);
+    ptrTimer->prev = NULL;
+    ptrTimer->next = *head;
+    if (*head != NULL)
+    {
+        (*head)->prev = ptrTimer;
+    }
+    *head = ptrTimer;
+}
+
+/* Must be called with interrupts disabled. */
+static void twheel_unlink(cy_stc_pdstack_twheel_t *ptrWheel, cy_stc_pdstack_twheel_timer_t *ptrTimer)
+{
+    cy_stc_pdstack_twheel_timer_t **head = twheel_list(ptrWheel, ptrTimer->slot);
+
+    if (ptrTimer->prev != NULL)
+    {
+        ptrTimer->prev->next = ptrTimer->next;
+    }
+    else
+    {
+        *head = ptrTimer->next;
+    }
+
+    if (ptrTimer->next != NULL)
+    {
+        ptrTimer->next->prev = ptrTimer->prev;
+    }
+
+    if ((*head == NULL) && (ptrTimer->slot != TWHEEL_SLOT_OVERFLOW))
+    {
+        ptrWheel->occupied[ptrTimer->slot / CY_PDSTACK_TWHEEL_SLOTS] &=
+            ~(1u << (ptrTimer->slot & TWHEEL_SLOT_MASK));
+    }
+
+    ptrTimer->next = NULL;
+    ptrTimer->prev = NULL;
+    ptrTimer->slot = TWHEEL_SLOT_IDLE;
+}
+
+/* Moves all entries of a list one level down, relative to the current tick. */
+static void twheel_cascade(cy_stc_pdstack_twheel_t *ptrWheel, uint8_t slot)
+{
+    cy_stc_pdstack_twheel_timer_t **head;
+    cy_stc_pdstack_twheel_timer_t *ptrTimer;
+    cy_stc_pdstack_twheel_timer_t *ptrNext;
+    uint32_t intState;
+
+    intState = Cy_SysLib_EnterCriticalSection();
+
+    /* Detach the list first: overflow entries may be linked back to it. */
+    head     = twheel_list(ptrWheel, slot);
+    ptrTimer = *head;
+    *head    = NULL;
+    if (slot != TWHEEL_SLOT_OVERFLOW)
+    {
+        ptrWheel->occupied[slot / CY_PDSTACK_TWHEEL_SLOTS] &= ~(1u << (slot & TWHEEL_SLOT_MASK));
+    }
+
+    while (ptrTimer != NULL)
+    {
+        ptrNext = ptrTimer->next;
+        twheel_link(ptrWheel, ptrTimer);
+        ptrTimer = ptrNext;
+    }
+
+    Cy_SysLib_ExitCriticalSection(intState);
+}
+
+/* Handles the current tick: cascades from the top, then fires level 0. */
+static void twheel_process(cy_stc_pdstack_twheel_t *ptrWheel)
+{
+    cy_stc_pdstack_twheel_timer_t *ptrTimer;
+    uint32_t intState;
+    uint32_t now = ptrWheel->now;
+    uint8_t level;
+    uint8_t slot;
+
+    if ((now & TWHEEL_RANGE_MASK) == 0u)
+    {
+        twheel_cascade(ptrWheel, TWHEEL_SLOT_OVERFLOW);
+    }
+
+    for (level = CY_PDSTACK_TWHEEL_LEVELS - 1u; level > 0u; level--)
+    {
+        if ((now & ((1u << (TWHEEL_LEVEL_BITS * level)) - 1u)) == 0u)
+        {
+            twheel_cascade(ptrWheel, (uint8_t)((level * CY_PDSTACK_TWHEEL_SLOTS) +
+                        ((now >> (TWHEEL_LEVEL_BITS * level)) & TWHEEL_SLOT_MASK)));
+        }
+    }
+
+    /* Entries are taken one at a time so that callbacks may start or stop any
+     * timer, including the other entries of this slot. */
+    slot = (uint8_t)(now & TWHEEL_SLOT_MASK);
+    for (;;)
+    {
+        intState = Cy_SysLib_EnterCriticalSection();
+        ptrTimer = ptrWheel->slot[0][slot];
+        if (ptrTimer != NULL)
+        {
+            twheel_unlink(ptrWheel, ptrTimer);
+            ptrWheel->activeCount--;
+        }
+        Cy_SysLib_ExitCriticalSection(intState);
+
+        if (ptrTimer == NULL)
+        {
+            break;
+        }
+
+        if (ptrTimer->cbk != NULL)
+        {
+            ptrTimer->cbk(ptrTimer->ptrPdStackContext, ptrTimer);
+        }
+    }
+}
+
+static uint32_t twheel_next_deadline(const cy_stc_pdstack_twheel_t *ptrWheel)
+{
+    uint32_t deadline = CY_PDSTACK_TWHEEL_NO_DEADLINE;
+    uint32_t now = ptrWheel->now;
+    uint32_t start;
+    uint32_t groupMask;
+    uint8_t level;
+
+    if (ptrWheel->overflow != NULL)
+    {
+        deadline = ((now | TWHEEL_RANGE_MASK) + 1u) - now;
+    }
+
+    /* The first occupied slot of each level is the next point in time at which
+     * the level has work; it always lies ahead of the current tick. */
+    for (level = 0u; level < CY_PDSTACK_TWHEEL_LEVELS; level++)
+    {
+        if (ptrWheel->occupied[level] != 0u)
+        {
+            groupMask = (1u << (TWHEEL_LEVEL_BITS * (level + 1u))) - 1u;
+            start = (now & ~groupMask) |
+                ((uint32_t)twheel_lowest_bit(ptrWheel->occupied[level]) << (TWHEEL_LEVEL_BITS * level));
+            if ((start - now) < deadline)
+            {
+                deadline = start - now;
+            }
+        }
+    }
+
+    return deadline;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_TimerWheel_Init(
+        cy_stc_pdstack_twheel_t *ptrWheel)
+{
+    uint8_t level;
+    uint8_t idx;
+
+    if (ptrWheel == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    for (level = 0u; level < CY_PDSTACK_TWHEEL_LEVELS; level++)
+    {
+        for (idx = 0u; idx < CY_PDSTACK_TWHEEL_SLOTS; idx++)
+        {
+            ptrWheel->slot[level][idx] = NULL;
+        }
+        ptrWheel->occupied[level] = 0u;
+    }
+
+    ptrWheel->overflow    = NULL;
+    ptrWheel->now         = 0u;
+    ptrWheel->activeCount = 0u;
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_TimerWheel_Start(
+        cy_stc_pdstack_twheel_t *ptrWheel,
+        cy_stc_pdstack_twheel_timer_t *ptrTimer,
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        uint16_t period,
+        cy_pdstack_twheel_cbk_t cbk)
+{
+    uint32_t intState;
+
+    if ((ptrWheel == NULL) || (ptrTimer == NULL) || (period == 0u) || (cbk == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intState = Cy_SysLib_EnterCriticalSection();
+    if (Cy_PdStack_TimerWheel_IsRunning(ptrTimer))
+    {
+        twheel_unlink(ptrWheel, ptrTimer);
+    }
+    else
+    {
+        ptrWheel->activeCount++;
+    }
+
+    ptrTimer->ptrPdStackContext = ptrPdStackContext;
+    ptrTimer->cbk               = cbk;
+    ptrTimer->expiry            = ptrWheel->now + period;
+    twheel_link(ptrWheel, ptrTimer);
+    Cy_SysLib_ExitCriticalSection(intState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_TimerWheel_Stop(
+        cy_stc_pdstack_twheel_t *ptrWheel,
+        cy_stc_pdstack_twheel_timer_t *ptrTimer)
+{
+    uint32_t intState;
+
+    if ((ptrWheel == NULL) || (ptrTimer == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intState = Cy_SysLib_EnterCriticalSection();
+    if (Cy_PdStack_TimerWheel_IsRunning(ptrTimer))
+    {
+        twheel_unlink(ptrWheel, ptrTimer);
+        ptrWheel->activeCount--;
+    }
+    Cy_SysLib_ExitCriticalSection(intState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+bool Cy_PdStack_TimerWheel_IsRunning(
+        const cy_stc_pdstack_twheel_timer_t *ptrTimer)
+{
+    /* Zero-initialized entries (slot 0 with no links) are not in any list. */
+    return ((ptrTimer != NULL) && (ptrTimer->slot != TWHEEL_SLOT_IDLE) &&
+            (ptrTimer->cbk != NULL));
+}
+
+cy_en_pdstack_status_t Cy_PdStack_TimerWheel_Advance(
+        cy_stc_pdstack_twheel_t *ptrWheel,
+        uint32_t elapsedMs)
+{
+    uint32_t intState;
+    uint32_t step;
+    bool due;
+
+    if (ptrWheel == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    while (elapsedMs != 0u)
+    {
+        /* Jump straight to the next tick which has work, or to the end. The
+         * deadline and the new tick are taken in one critical section so
+         * that a timer started from an interrupt cannot be skipped. */
+        intState = Cy_SysLib_EnterCriticalSection();
+        step = twheel_next_deadline(ptrWheel);
+        due  = (step <= elapsedMs);
+        if (!due)
+        {
+            step = elapsedMs;
+        }
+        ptrWheel->now += step;
+        Cy_SysLib_ExitCriticalSection(intState);
+
+        elapsedMs -= step;
+        if (due)
+        {
+            twheel_process(ptrWheel);
+        }
+    }
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_TimerWheel_GetNextDeadline(
+        cy_stc_pdstack_twheel_t *ptrWheel,
+        uint32_t *ptrDeadlineMs)
+{
+    uint32_t intState;
+
+    if ((ptrWheel == NULL) || (ptrDeadlineMs == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intState = Cy_SysLib_EnterCriticalSection();
+    *ptrDeadlineMs = twheel_next_deadline(ptrWheel);
+    Cy_SysLib_ExitCriticalSection(intState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+#endif /* (CY_PD_TIMER_WHEEL_ENABLE) */
+
+/* [] END OF FILE */
@@ -0,0 +1,238 @@
+/***************************************************************************//**
+* \file cy_pdstack_timer_wheel.h
+* \version 4.0
+*
+* Header file of the hierarchical timer wheel of the PDStack middleware.
+* Starting and stopping a timer and finding the next deadline take constant
+* time irrespective of the number of ports and running timers.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_TIMER_WHEEL_H)
+#define CY_PDSTACK_TIMER_WHEEL_H
+
+#include "cy_pdstack_common.h"
+
+/*******************************************************************************
+*                              Type definitions
+*******************************************************************************/
+
+/**
+* \addtogroup group_pdstack_macros
+* \{
+*/
+
+/** Number of slots on each level of the timer wheel. */
+#define CY_PDSTACK_TWHEEL_SLOTS                 (32u)
+
+/** Number of levels of the timer wheel. Level n has a resolution of 32^n ms. */
+#define CY_PDSTACK_TWHEEL_LEVELS                (3u)
+
+/** Deadline value reported when no timer is running. */
+#define CY_PDSTACK_TWHEEL_NO_DEADLINE           (0xFFFFFFFFu)
+
+/** \} group_pdstack_macros */
+
+/**
+* \addtogroup group_pdstack_data_structures
+* \{
+*/
+
+struct cy_stc_pdstack_twheel_timer;
+
+/**
+ * @brief Timer wheel expiry callback. Invoked from
+ * Cy_PdStack_TimerWheel_Advance; the timer may be restarted from the callback.
+ *
+ * @param ptrPdStackContext PD stack context passed when the timer was started.
+ * @param ptrTimer Pointer to the expired timer.
+ */
+typedef void (*cy_pdstack_twheel_cbk_t)(
+        struct cy_stc_pdstack_context *ptrPdStackContext,
+        struct cy_stc_pdstack_twheel_timer *ptrTimer);
+
+/**
+ * @brief Timer wheel entry. Allocated by the user of the timer, typically
+ * within its per-port state. All members are managed by the
+ * Cy_PdStack_TimerWheel_* functions.
+ */
+typedef struct cy_stc_pdstack_twheel_timer
+{
+    struct cy_stc_pdstack_twheel_timer *next;           /**< Next entry in the slot. */
+    struct cy_stc_pdstack_twheel_timer *prev;           /**< Previous entry in the slot. */
+    struct cy_stc_pdstack_context      *ptrPdStackContext; /**< Context passed to the callback. */
+    cy_pdstack_twheel_cbk_t             cbk;            /**< Expiry callback. */
+    uint32_t                            expiry;         /**< Absolute expiry tick. */
+    uint8_t                             slot;           /**< Slot holding the entry, 0xFF when idle. */
+} cy_stc_pdstack_twheel_timer_t;
+
+/**
+ * @brief Hierarchical timer wheel with a 1 ms tick. A single wheel is
+ * normally shared by all ports.
+ */
+typedef struct
+{
+    cy_stc_pdstack_twheel_timer_t *slot[CY_PDSTACK_TWHEEL_LEVELS][CY_PDSTACK_TWHEEL_SLOTS];
+                                                        /**< Slot list heads. */
+    cy_stc_pdstack_twheel_timer_t *overflow;            /**< Entries beyond the range of the top level. */
+    uint32_t    occupied[CY_PDSTACK_TWHEEL_LEVELS];     /**< Bit n set if slot n of the level is not empty. */
+    uint32_t    now;                                    /**< Current tick. */
+    uint16_t    activeCount;                            /**< Number of running timers. */
+} cy_stc_pdstack_twheel_t;
+
+/** \} group_pdstack_data_structures */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_TimerWheel_Init
+****************************************************************************//**
+*
+* Initializes the timer wheel. No timer is running after this call.
+*
+* \param ptrWheel
+* Pointer to the timer wheel.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_TimerWheel_Init(
+        cy_stc_pdstack_twheel_t *ptrWheel);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_TimerWheel_Start
+****************************************************************************//**
+*
+* Starts or restarts a timer. This function is safe to be called from
+* interrupt context.
+*
+* \param ptrWheel
+* Pointer to the timer wheel.
+*
+* \param ptrTimer
+* Pointer to the timer entry. Must not be in use on a different wheel.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer passed to the callback.
+*
+* \param period
+* Timer period in ms. Must be non-zero.
+*
+* \param cbk
+* Expiry callback.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the timer has been started.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_TimerWheel_Start(
+        cy_stc_pdstack_twheel_t *ptrWheel,
+        cy_stc_pdstack_twheel_timer_t *ptrTimer,
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        uint16_t period,
+        cy_pdstack_twheel_cbk_t cbk);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_TimerWheel_Stop
+****************************************************************************//**
+*
+* Stops a timer. Stopping a timer which is not running has no effect. This
+* function is safe to be called from interrupt context.
+*
+* \param ptrWheel
+* Pointer to the timer wheel.
+*
+* \param ptrTimer
+* Pointer to the timer entry.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_TimerWheel_Stop(
+        cy_stc_pdstack_twheel_t *ptrWheel,
+        cy_stc_pdstack_twheel_timer_t *ptrTimer);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_TimerWheel_IsRunning
+****************************************************************************//**
+*
+* Checks whether a timer is running.
+*
+* \param ptrTimer
+* Pointer to the timer entry.
+*
+* \return
+* true if the timer is running, false otherwise.
+*
+*******************************************************************************/
+bool Cy_PdStack_TimerWheel_IsRunning(
+        const cy_stc_pdstack_twheel_timer_t *ptrTimer);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_TimerWheel_Advance
+****************************************************************************//**
+*
+* Moves the wheel forward and invokes the callbacks of all timers which expire
+* on the way. Can be called from a periodic 1 ms tick, or once after a sleep
+* period with the time actually elapsed: empty stretches of the wheel are
+* skipped without being visited.
+*
+* \param ptrWheel
+* Pointer to the timer wheel.
+*
+* \param elapsedMs
+* Time elapsed since the previous call in ms.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_TimerWheel_Advance(
+        cy_stc_pdstack_twheel_t *ptrWheel,
+        uint32_t elapsedMs);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_TimerWheel_GetNextDeadline
+****************************************************************************//**
+*
+* Reports the time until Cy_PdStack_TimerWheel_Advance next has work to do.
+* This is the earliest timer expiry, or an earlier point at which timers of a
+* coarse level are moved to a finer level. The value is suited for
+* programming a single hardware compare before entering deep sleep.
+*
+* \param ptrWheel
+* Pointer to the timer wheel.
+*
+* \param ptrDeadlineMs
+* Output parameter which receives the time in ms, or
+* CY_PDSTACK_TWHEEL_NO_DEADLINE if no timer is running.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_TimerWheel_GetNextDeadline(
+        cy_stc_pdstack_twheel_t *ptrWheel,
+        uint32_t *ptrDeadlineMs);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_TIMER_WHEEL_H */
+
+/* [] END OF FILE */
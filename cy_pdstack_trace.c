@@ -0,0 +1,288 @@
+/***************************************************************************//**
+* \file cy_pdstack_trace.c
+* \version 4.0
+*
+* Source file of the binary event trace of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include "cy_syslib.h"
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_trace.h"
+#include "cy_pdstack_perf.h"
+
+#if (CY_PD_TRACE_ENABLE)
+
+/* Can be overridden to trace with a time base of its own. */
+#ifndef CY_PD_TRACE_GET_TIME
+#define CY_PD_TRACE_GET_TIME()          CY_PDSTACK_GET_TIME_US()
+#endif /* CY_PD_TRACE_GET_TIME */
+
+#define TRACE_MASK                      ((uint16_t)(CY_PD_TRACE_DEPTH - 1u))
+
+typedef struct
+{
+    cy_stc_pdstack_trace_t          ring;
+
+    /* States seen by the previous poll. */
+    uint8_t                         lastTypecState;
+    uint8_t                         lastPeState;
+    bool                            init;
+} trace_port_t;
+
+static trace_port_t gl_trace[CY_PD_MAX_NO_OF_PORTS];
+
+static trace_port_t *trace_get(const cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    if ((ptrPdStackContext == NULL) || (ptrPdStackContext->port >= CY_PD_MAX_NO_OF_PORTS))
+    {
+        return NULL;
+    }
+
+    return &gl_trace[ptrPdStackContext->port];
+}
+
+static uint8_t trace_log2(uint32_t val)
+{
+    uint8_t ret = 0u;
+
+    while (val > 1u)
+    {
+        val >>= 1u;
+        ret++;
+    }
+
+    return ret;
+}
+
+static void trace_init(const cy_stc_pdstack_context_t *ptrPdStackContext, trace_port_t *ptrTrace)
+{
+    ptrTrace->ring.port      = ptrPdStackContext->port;
+    ptrTrace->ring.depthLog2 = trace_log2(CY_PD_TRACE_DEPTH);
+    ptrTrace->lastTypecState = (uint8_t)ptrPdStackContext->dpmStat.typecFsmState;
+    ptrTrace->lastPeState    = (uint8_t)ptrPdStackContext->dpmStat.peFsmState;
+    ptrTrace->init           = true;
+}
+
+void Cy_PdStack_Dpm_TraceWrite(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_trace_type_t type,
+        uint8_t arg0,
+        uint16_t arg1)
+{
+    trace_port_t *ptrTrace = trace_get(ptrPdStackContext);
+    cy_stc_pdstack_trace_rec_t *ptrRec;
+    uint32_t intrState;
+
+    if (ptrTrace == NULL)
+    {
+        return;
+    }
+
+    if (!ptrTrace->init)
+    {
+        trace_init(ptrPdStackContext, ptrTrace);
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    ptrRec = &ptrTrace->ring.rec[ptrTrace->ring.wrIdx & TRACE_MASK];
+    ptrRec->time = (uint32_t)CY_PD_TRACE_GET_TIME();
+    ptrRec->type = (uint8_t)type;
+    ptrRec->arg0 = arg0;
+    ptrRec->arg1 = arg1;
+    ptrTrace->ring.wrIdx++;
+    Cy_SysLib_ExitCriticalSection(intrState);
+}
+
+void Cy_PdStack_Dpm_TracePoll(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    trace_port_t *ptrTrace = trace_get(ptrPdStackContext);
+    uint8_t state;
+
+    if (ptrTrace == NULL)
+    {
+        return;
+    }
+
+    if (!ptrTrace->init)
+    {
+        trace_init(ptrPdStackContext, ptrTrace);
+    }
+
+    state = (uint8_t)ptrPdStackContext->dpmStat.typecFsmState;
+    if (state != ptrTrace->lastTypecState)
+    {
+        Cy_PdStack_Dpm_TraceWrite(ptrPdStackContext, CY_PDSTACK_TRACE_TYPEC_STATE, state, ptrTrace->lastTypecState);
+        ptrTrace->lastTypecState = state;
+    }
+
+    state = (uint8_t)ptrPdStackContext->dpmStat.peFsmState;
+    if (state != ptrTrace->lastPeState)
+    {
+        Cy_PdStack_Dpm_TraceWrite(ptrPdStackContext, CY_PDSTACK_TRACE_PE_STATE, state, ptrTrace->lastPeState);
+        ptrTrace->lastPeState = state;
+    }
+}
+
+void Cy_PdStack_Dpm_TraceEvent(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data)
+{
+    const cy_stc_pdstack_pd_packet_t *ptrPkt;
+    uint16_t detail = 0u;
+
+    if (trace_get(ptrPdStackContext) == NULL)
+    {
+        return;
+    }
+
+    /* Events are raised from inside state handlers, so catch up on the state
+     * first to keep the records in order. */
+    Cy_PdStack_Dpm_TracePoll(ptrPdStackContext);
+
+    switch (evt)
+    {
+#if DPM_DEBUG_SUPPORT
+        case APP_EVT_HARD_RESET_RCVD:
+        case APP_EVT_HARD_RESET_SENT:
+            detail = ptrPdStackContext->dpmStat.hardResetReason;
+            break;
+#endif /* DPM_DEBUG_SUPPORT */
+
+        case APP_EVT_PD_CONTRACT_NEGOTIATION_COMPLETE:
+            if (data != NULL)
+            {
+                detail = (uint16_t)((const cy_stc_pdstack_pd_contract_info_t *)data)->status;
+            }
+            break;
+
+        case APP_EVT_PKT_RCVD:
+            ptrPkt = (const cy_stc_pdstack_pd_packet_t *)data;
+            if (ptrPkt != NULL)
+            {
+                Cy_PdStack_Dpm_TraceWrite(ptrPdStackContext, CY_PDSTACK_TRACE_MSG_RX, 0u,
+                        CY_PDSTACK_TRACE_MSG_INFO(ptrPkt->sop, (ptrPkt->hdr.val >> 15u), ptrPkt->len, ptrPkt->msg));
+            }
+            return;
+
+        default:
+            /* No detail for the remaining events. */
+            break;
+    }
+
+    Cy_PdStack_Dpm_TraceWrite(ptrPdStackContext, CY_PDSTACK_TRACE_APP_EVT, (uint8_t)evt, detail);
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_GetTrace(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_trace_rec_t *ptrRec,
+        uint16_t maxCount,
+        uint16_t *ptrCount)
+{
+    trace_port_t *ptrTrace = trace_get(ptrPdStackContext);
+    uint32_t intrState;
+    uint16_t wrIdx;
+    uint16_t idx;
+    uint16_t count;
+    uint16_t copied = 0u;
+    uint16_t i;
+    bool overwritten = false;
+
+    if ((ptrTrace == NULL) || (ptrRec == NULL) || (ptrCount == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    wrIdx = ptrTrace->ring.wrIdx;
+
+    /* The ring is full once the slot to be written next has been used. */
+    count = (ptrTrace->ring.rec[wrIdx & TRACE_MASK].type != (uint8_t)CY_PDSTACK_TRACE_NONE) ?
+        (uint16_t)CY_PD_TRACE_DEPTH : (uint16_t)(wrIdx & TRACE_MASK);
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    if (count > maxCount)
+    {
+        count = maxCount;
+    }
+
+    /* Copied newest first, one record per critical section. Once the writer
+     * has overtaken the next older record, the older ones are lost and the
+     * copy ends. */
+    while ((copied < count) && (!overwritten))
+    {
+        idx = (uint16_t)(wrIdx - copied - 1u);
+
+        intrState = Cy_SysLib_EnterCriticalSection();
+        overwritten = ((uint16_t)(ptrTrace->ring.wrIdx - idx) > (uint16_t)CY_PD_TRACE_DEPTH);
+        if (!overwritten)
+        {
+            ptrRec[count - copied - 1u] = ptrTrace->ring.rec[idx & TRACE_MASK];
+            copied++;
+        }
+        Cy_SysLib_ExitCriticalSection(intrState);
+    }
+
+    /* Move the records to the start of the buffer, oldest first. */
+    for (i = 0u; i < copied; i++)
+    {
+        ptrRec[i] = ptrRec[(count - copied) + i];
+    }
+
+    *ptrCount = copied;
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+const cy_stc_pdstack_trace_t *Cy_PdStack_Dpm_GetTraceRing(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    trace_port_t *ptrTrace = trace_get(ptrPdStackContext);
+
+    if (ptrTrace == NULL)
+    {
+        return NULL;
+    }
+
+    if (!ptrTrace->init)
+    {
+        trace_init(ptrPdStackContext, ptrTrace);
+    }
+
+    return &ptrTrace->ring;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_ClearTrace(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    trace_port_t *ptrTrace = trace_get(ptrPdStackContext);
+    uint32_t intrState;
+    uint16_t i;
+
+    if (ptrTrace == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    for (i = 0u; i < CY_PD_TRACE_DEPTH; i++)
+    {
+        ptrTrace->ring.rec[i].type = (uint8_t)CY_PDSTACK_TRACE_NONE;
+    }
+    ptrTrace->ring.wrIdx = 0u;
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+#endif /* (CY_PD_TRACE_ENABLE) */
+
+/* [] END OF FILE */
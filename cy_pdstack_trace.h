@@ -0,0 +1,246 @@
+/***************************************************************************//**
+* \file cy_pdstack_trace.h
+* \version 4.0
+*
+* Header file of the binary event trace of the PDStack middleware. Type-C and
+* policy engine state changes, application events and received messages are
+* recorded as fixed-size binary records in a per-port ring, which can be read
+* while the stack is running.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_TRACE_H)
+#define CY_PDSTACK_TRACE_H
+
+#include "cy_pdstack_common.h"
+
+#if ((CY_PD_TRACE_DEPTH == 0u) || (CY_PD_TRACE_DEPTH > 256u) || \
+     ((CY_PD_TRACE_DEPTH & (CY_PD_TRACE_DEPTH - 1u)) != 0u))
+#error "CY_PD_TRACE_DEPTH must be a power of two in the range 1 to 256."
+#endif
+
+/**
+* \addtogroup group_pdstack_macros
+* \{
+*/
+
+/** Builds the arg1 value of a CY_PDSTACK_TRACE_MSG_RX record: message code in
+ * bits 4:0, number of data objects in bits 8:5, extended flag in bit 9 and SOP
+ * type in bits 12:10. */
+#define CY_PDSTACK_TRACE_MSG_INFO(sop, extd, len, msg)                          \
+    ((uint16_t)(((((uint32_t)(sop)) & 0x7u) << 10u) | ((((uint32_t)(extd)) & 0x1u) << 9u) | \
+                ((((uint32_t)(len)) & 0xFu) << 5u) | (((uint32_t)(msg)) & 0x1Fu)))
+
+/** \} group_pdstack_macros */
+
+/**
+* \addtogroup group_pdstack_enums
+* \{
+*/
+
+/**
+ * @typedef cy_en_pdstack_trace_type_t
+ * @brief Types of trace records. The meaning of arg0 and arg1 is given for
+ * each type.
+ */
+typedef enum
+{
+    CY_PDSTACK_TRACE_NONE = 0,          /**< 0x00: Unused record. */
+    CY_PDSTACK_TRACE_TYPEC_STATE,       /**< 0x01: Type-C state change. arg0: new cy_en_pdstack_typec_fsm_state_t,
+                                             arg1: previous state. */
+    CY_PDSTACK_TRACE_PE_STATE,          /**< 0x02: PE state change. arg0: new cy_en_pdstack_pe_fsm_state_t,
+                                             arg1: previous state. */
+    CY_PDSTACK_TRACE_APP_EVT,           /**< 0x03: Application event. arg0: cy_en_pdstack_app_evt_t, arg1:
+                                             cy_en_pdstack_hard_reset_reason_t for hard reset events
+                                             when DPM_DEBUG_SUPPORT is set,
+                                             cy_en_pdstack_contract_status_t for contract completion, else 0. */
+    CY_PDSTACK_TRACE_MSG_RX,            /**< 0x04: Message received. arg0: 0, arg1: CY_PDSTACK_TRACE_MSG_INFO. */
+    CY_PDSTACK_TRACE_DPM_CMD,           /**< 0x05: DPM command. arg0: cy_en_pdstack_dpm_pd_cmd_t, arg1:
+                                             cy_en_pdstack_resp_status_t. */
+    CY_PDSTACK_TRACE_TIMER,             /**< 0x06: Expiry of a soft timer of the optional modules (EPR
+                                             keepalive, PPS stream, discovery, event coalescing, telemetry).
+                                             arg0: 0, arg1: timer ID. */
+    CY_PDSTACK_TRACE_USER = 0x80        /**< 0x80: First type available to the application. */
+} cy_en_pdstack_trace_type_t;
+
+/** \} group_pdstack_enums */
+
+/**
+* \addtogroup group_pdstack_data_structures
+* \{
+*/
+
+/**
+ * @brief Trace record. Eight bytes, little-endian on all supported devices.
+ */
+typedef struct
+{
+    uint32_t    time;           /**< Value of CY_PD_TRACE_GET_TIME, by default
+                                     CY_PDSTACK_GET_TIME_US, when the record was written. */
+    uint8_t     type;           /**< Record type, cy_en_pdstack_trace_type_t. */
+    uint8_t     arg0;           /**< First argument. */
+    uint16_t    arg1;           /**< Second argument. */
+} cy_stc_pdstack_trace_rec_t;
+
+/**
+ * @brief Per-port trace ring. The layout is fixed so that the ring can be read
+ * as a memory region, for example over HPI, and decoded on a host with
+ * tools/pdstack_trace_decode.py.
+ */
+typedef struct
+{
+    uint8_t                     port;                               /**< USB PD port index. */
+    uint8_t                     depthLog2;                          /**< log2 of the number of records. */
+    volatile uint16_t           wrIdx;                              /**< Free-running write index. */
+    cy_stc_pdstack_trace_rec_t  rec[CY_PD_TRACE_DEPTH];             /**< Records, slot wrIdx % depth is
+                                                                         written next. */
+} cy_stc_pdstack_trace_t;
+
+/** \} group_pdstack_data_structures */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_TraceWrite
+****************************************************************************//**
+*
+* Writes one record. Can be called from any context; the cost is a time stamp
+* read and an eight byte store inside a short critical section.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param type
+* Record type.
+*
+* \param arg0
+* First argument.
+*
+* \param arg1
+* Second argument.
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_TraceWrite(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_trace_type_t type,
+        uint8_t arg0,
+        uint16_t arg1);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_TracePoll
+****************************************************************************//**
+*
+* Records Type-C and policy engine state changes since the previous call.
+* Called from Cy_PdStack_Dpm_TaskPending when CY_PD_EVENT_DRIVEN_TASK_ENABLE is
+* set and from Cy_PdStack_Dpm_TraceEvent; otherwise it should be called after
+* Cy_PdStack_Dpm_Task.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_TracePoll(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_TraceEvent
+****************************************************************************//**
+*
+* Records an application event and, for APP_EVT_PKT_RCVD, the received
+* message. Intended to be the first call of the application event handler.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param evt
+* Event ID.
+*
+* \param data
+* Event data.
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_TraceEvent(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_GetTrace
+****************************************************************************//**
+*
+* Copies the most recent records, oldest first, without stopping the stack.
+* Records are copied one at a time with interrupts disabled. Records which
+* are overwritten by new ones during the copy are left out, so fewer records
+* than available may be returned while the trace is busy.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param ptrRec
+* Buffer which receives the records.
+*
+* \param maxCount
+* Capacity of the buffer in records.
+*
+* \param ptrCount
+* Output parameter which receives the number of records copied.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the parameters are invalid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_GetTrace(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_stc_pdstack_trace_rec_t *ptrRec,
+        uint16_t maxCount,
+        uint16_t *ptrCount);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_GetTraceRing
+****************************************************************************//**
+*
+* Returns the trace ring of the port, for exposing it as a memory region
+* through HPI or a debugger.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* Pointer to the trace ring, NULL if the parameters are invalid.
+*
+*******************************************************************************/
+const cy_stc_pdstack_trace_t *Cy_PdStack_Dpm_GetTraceRing(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_ClearTrace
+****************************************************************************//**
+*
+* Discards all records of the port.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the parameters are invalid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_ClearTrace(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_TRACE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,492 @@
+/***************************************************************************//**
+* \file cy_pdstack_vdm_disc.c
+* \version 4.0
+*
+* Source file of the pipelined SOP discovery engine of the PDStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "cy_syslib.h"
+#include "cy_pdstack_common.h"
+#include "cy_pdstack_dpm.h"
+#include "cy_pdstack_vdm_disc.h"
+#if (CY_PD_EVENT_DRIVEN_TASK_ENABLE)
+#include "cy_pdstack_sched.h"
+#endif /* (CY_PD_EVENT_DRIVEN_TASK_ENABLE) */
+#if (CY_PD_TRACE_ENABLE)
+#include "cy_pdstack_trace.h"
+#endif /* (CY_PD_TRACE_ENABLE) */
+
+#if ((CY_PD_VDM_DISC_ENABLE) && (!(CY_PD_VDM_DISABLE)))
+
+/* Modal Operation Supported flag of the ID header VDO. */
+#define DISC_ID_HDR_MODAL_POS           (26u)
+
+/* Discover SVIDs responses are repeated until one is not full. Bounds the
+ * number of requests for partners which keep reporting full responses. */
+#define DISC_SVID_REQ_MAX               ((CY_PD_VDM_DISC_MAX_SVIDS / 12u) + 2u)
+
+#define DISC_TIMER_ID(ptrPdStackContext)                                        \
+    ((cy_timer_id_t)(CY_PDSTACK_VDM_DISC_TIMER_BASE_ID + (ptrPdStackContext)->port))
+
+typedef enum
+{
+    DISC_STEP_ID = 0,
+    DISC_STEP_SVIDS,
+    DISC_STEP_MODES
+} disc_step_t;
+
+typedef struct
+{
+    cy_stc_pdstack_vdm_disc_table_t     table;
+    cy_pdstack_vdm_disc_cbk_t           doneCbk;
+    disc_step_t                         step;
+    uint8_t                             svidIdx;
+    uint8_t                             svidReq;
+    uint8_t                             retry;
+    bool                                cached;
+
+    /* Request to be sent from the task. */
+    volatile bool                       pending;
+    volatile bool                       holdOff;
+
+    /* Discovery VDM, owned by the stack until disc_cbk reports on it. */
+    cy_stc_pdstack_dpm_pd_cmd_buf_t     cmdBuf;
+} disc_port_t;
+
+static disc_port_t gl_vdmDisc[CY_PD_MAX_NO_OF_PORTS];
+
+static void disc_cbk(cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_resp_status_t resp, const cy_stc_pdstack_pd_packet_t *pkt_ptr);
+
+static disc_port_t *disc_get(const cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    if ((ptrPdStackContext == NULL) || (ptrPdStackContext->port >= CY_PD_MAX_NO_OF_PORTS))
+    {
+        return NULL;
+    }
+
+    return &gl_vdmDisc[ptrPdStackContext->port];
+}
+
+static void disc_kick(cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+#if (CY_PD_EVENT_DRIVEN_TASK_ENABLE)
+    (void)Cy_PdStack_Dpm_SetSchedHook(CY_PDSTACK_SCHED_HOOK_VDM_DISC, Cy_PdStack_Dpm_VdmDiscTask);
+    (void)Cy_PdStack_Dpm_SetPendingWork(ptrPdStackContext, CY_PDSTACK_PEND_APP);
+#else
+    CY_UNUSED_PARAMETER(ptrPdStackContext);
+#endif /* (CY_PD_EVENT_DRIVEN_TASK_ENABLE) */
+}
+
+static void disc_send(cy_stc_pdstack_context_t *ptrPdStackContext, disc_port_t *ptrDisc)
+{
+    /* From the response callback the stack is usually still completing the
+     * previous sequence; the task then sends the request on its next pass. */
+    ptrDisc->pending = (Cy_PdStack_Dpm_SendPdCommand(ptrPdStackContext, CY_PDSTACK_DPM_CMD_SEND_VDM,
+                &ptrDisc->cmdBuf, false, disc_cbk) != CY_PDSTACK_STAT_SUCCESS);
+    if (ptrDisc->pending)
+    {
+        disc_kick(ptrPdStackContext);
+    }
+}
+
+static void disc_request(cy_stc_pdstack_context_t *ptrPdStackContext, disc_port_t *ptrDisc)
+{
+    uint32_t svid = CY_PD_STD_SVID;
+    uint32_t cmd;
+
+    switch (ptrDisc->step)
+    {
+        case DISC_STEP_ID:
+            cmd = (uint32_t)CY_PDSTACK_VDM_CMD_DSC_IDENTITY;
+            break;
+
+        case DISC_STEP_SVIDS:
+            cmd = (uint32_t)CY_PDSTACK_VDM_CMD_DSC_SVIDS;
+            break;
+
+        default:
+            svid = ptrDisc->table.svid[ptrDisc->svidIdx].svid;
+            cmd  = (uint32_t)CY_PDSTACK_VDM_CMD_DSC_MODES;
+            break;
+    }
+
+    ptrDisc->cmdBuf.cmdSop       = CY_PD_SOP;
+    ptrDisc->cmdBuf.noOfCmdDo    = 1u;
+    ptrDisc->cmdBuf.timeout      = CY_PD_VDM_RESPONSE_TIMER_PERIOD;
+    ptrDisc->cmdBuf.cmdDo[0].val = (svid << 16u) | ((uint32_t)CY_PDSTACK_VDM_TYPE_STRUCTURED << 15u) |
+        ((uint32_t)ptrDisc->table.vdmVersion << CY_PD_STD_VDM_VERSION_IDX) | cmd;
+
+    disc_send(ptrPdStackContext, ptrDisc);
+}
+
+static void disc_finish(cy_stc_pdstack_context_t *ptrPdStackContext, disc_port_t *ptrDisc,
+        cy_en_pdstack_vdm_disc_status_t status)
+{
+    ptrDisc->table.status = status;
+    ptrDisc->cached       = (status == CY_PDSTACK_VDM_DISC_COMPLETE);
+    ptrDisc->pending      = false;
+    if (ptrDisc->holdOff)
+    {
+        ptrDisc->holdOff = false;
+        Cy_PdUtils_SwTimer_Stop(ptrPdStackContext->ptrTimerContext, DISC_TIMER_ID(ptrPdStackContext));
+    }
+
+    if (ptrDisc->doneCbk != NULL)
+    {
+        ptrDisc->doneCbk(ptrPdStackContext, &ptrDisc->table);
+    }
+}
+
+/* Moves on to Discover Modes of the next SVID, or completes the discovery. */
+static void disc_next_svid(cy_stc_pdstack_context_t *ptrPdStackContext, disc_port_t *ptrDisc)
+{
+    ptrDisc->retry = 0u;
+    if (ptrDisc->svidIdx < ptrDisc->table.numSvids)
+    {
+        ptrDisc->step = DISC_STEP_MODES;
+        disc_request(ptrPdStackContext, ptrDisc);
+    }
+    else
+    {
+        disc_finish(ptrPdStackContext, ptrDisc, CY_PDSTACK_VDM_DISC_COMPLETE);
+    }
+}
+
+static void disc_add_svid(disc_port_t *ptrDisc, uint16_t svid)
+{
+    cy_stc_pdstack_vdm_disc_table_t *ptrTable = &ptrDisc->table;
+    uint8_t i;
+
+    for (i = 0u; i < ptrTable->numSvids; i++)
+    {
+        if (ptrTable->svid[i].svid == svid)
+        {
+            return;
+        }
+    }
+
+    if (ptrTable->numSvids < CY_PD_VDM_DISC_MAX_SVIDS)
+    {
+        ptrTable->svid[ptrTable->numSvids].svid = svid;
+        ptrTable->numSvids++;
+    }
+    else
+    {
+        ptrTable->svidOverflow = true;
+    }
+}
+
+/* Returns true if the SVID list continues in another response. */
+static bool disc_parse_svids(disc_port_t *ptrDisc, const cy_stc_pdstack_pd_packet_t *pkt_ptr)
+{
+    uint16_t svid;
+    uint8_t i;
+    uint8_t j;
+
+    for (i = 1u; i < pkt_ptr->len; i++)
+    {
+        for (j = 0u; j < 2u; j++)
+        {
+            svid = (uint16_t)(pkt_ptr->dat[i].val >> ((j == 0u) ? 16u : 0u));
+            if (svid == 0u)
+            {
+                return false;
+            }
+            disc_add_svid(ptrDisc, svid);
+        }
+    }
+
+    return (pkt_ptr->len == CY_PD_MAX_NO_OF_DO);
+}
+
+static void disc_ack(cy_stc_pdstack_context_t *ptrPdStackContext, disc_port_t *ptrDisc,
+        const cy_stc_pdstack_pd_packet_t *pkt_ptr)
+{
+    cy_stc_pdstack_vdm_disc_table_t *ptrTable = &ptrDisc->table;
+    cy_stc_pdstack_vdm_disc_svid_t *ptrSvid;
+    uint8_t ver = (uint8_t)CY_PD_GET_SVDM_VDM_VER(pkt_ptr->dat[0].val);
+    uint8_t count = pkt_ptr->len - 1u;
+    uint8_t i;
+
+    ptrDisc->retry = 0u;
+
+    switch (ptrDisc->step)
+    {
+        case DISC_STEP_ID:
+            /* Continue with the lower of both VDM versions. */
+            if (ver < ptrTable->vdmVersion)
+            {
+                ptrTable->vdmVersion = ver;
+            }
+            ptrTable->idCount = (count < (CY_PD_MAX_NO_OF_VDO - 1u)) ? count : (CY_PD_MAX_NO_OF_VDO - 1u);
+            for (i = 0u; i < ptrTable->idCount; i++)
+            {
+                ptrTable->idVdo[i] = pkt_ptr->dat[i + 1u].val;
+            }
+
+            if ((ptrTable->idCount == 0u) || (((ptrTable->idVdo[0] >> DISC_ID_HDR_MODAL_POS) & 0x1u) == 0u))
+            {
+                disc_finish(ptrPdStackContext, ptrDisc, CY_PDSTACK_VDM_DISC_COMPLETE);
+            }
+            else
+            {
+                ptrDisc->step = DISC_STEP_SVIDS;
+                disc_request(ptrPdStackContext, ptrDisc);
+            }
+            break;
+
+        case DISC_STEP_SVIDS:
+            ptrDisc->svidReq++;
+            if ((disc_parse_svids(ptrDisc, pkt_ptr)) && (!ptrTable->svidOverflow) &&
+                    (ptrDisc->svidReq < DISC_SVID_REQ_MAX))
+            {
+                disc_request(ptrPdStackContext, ptrDisc);
+            }
+            else
+            {
+                ptrDisc->svidIdx = 0u;
+                disc_next_svid(ptrPdStackContext, ptrDisc);
+            }
+            break;
+
+        default:
+            ptrSvid           = &ptrTable->svid[ptrDisc->svidIdx];
+            ptrSvid->ack      = true;
+            ptrSvid->numModes = (count < CY_PDSTACK_VDM_DISC_MAX_MODES) ? count : CY_PDSTACK_VDM_DISC_MAX_MODES;
+            for (i = 0u; i < ptrSvid->numModes; i++)
+            {
+                ptrSvid->modeVdo[i] = pkt_ptr->dat[i + 1u].val;
+            }
+            ptrDisc->svidIdx++;
+            disc_next_svid(ptrPdStackContext, ptrDisc);
+            break;
+    }
+}
+
+/* NAK, or no answer after the retries. */
+static void disc_nak(cy_stc_pdstack_context_t *ptrPdStackContext, disc_port_t *ptrDisc)
+{
+    switch (ptrDisc->step)
+    {
+        case DISC_STEP_ID:
+            disc_finish(ptrPdStackContext, ptrDisc, CY_PDSTACK_VDM_DISC_NOT_SUPPORTED);
+            break;
+
+        case DISC_STEP_SVIDS:
+            /* Keep the SVIDs of the responses received so far. */
+            ptrDisc->svidIdx = 0u;
+            disc_next_svid(ptrPdStackContext, ptrDisc);
+            break;
+
+        default:
+            ptrDisc->table.svid[ptrDisc->svidIdx].ack = false;
+            ptrDisc->svidIdx++;
+            disc_next_svid(ptrPdStackContext, ptrDisc);
+            break;
+    }
+}
+
+static void disc_busy_cbk(cy_timer_id_t id, void *callbackContext)
+{
+    cy_stc_pdstack_context_t *ptrPdStackContext = (cy_stc_pdstack_context_t *)callbackContext;
+    disc_port_t *ptrDisc = disc_get(ptrPdStackContext);
+
+    CY_UNUSED_PARAMETER(id);
+
+    if (ptrDisc != NULL)
+    {
+#if (CY_PD_TRACE_ENABLE)
+        Cy_PdStack_Dpm_TraceWrite(ptrPdStackContext, CY_PDSTACK_TRACE_TIMER, 0u, (uint16_t)id);
+#endif /* (CY_PD_TRACE_ENABLE) */
+        ptrDisc->holdOff = false;
+        ptrDisc->pending = true;
+        disc_kick(ptrPdStackContext);
+    }
+}
+
+static void disc_cbk(cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_resp_status_t resp, const cy_stc_pdstack_pd_packet_t *pkt_ptr)
+{
+    disc_port_t *ptrDisc = disc_get(ptrPdStackContext);
+    uint32_t cmdType;
+
+    if ((ptrDisc == NULL) || (ptrDisc->table.status != CY_PDSTACK_VDM_DISC_RUNNING) ||
+            (resp == CY_PDSTACK_CMD_SENT))
+    {
+        return;
+    }
+
+    if (resp == CY_PDSTACK_SEQ_ABORTED)
+    {
+        disc_finish(ptrPdStackContext, ptrDisc, CY_PDSTACK_VDM_DISC_ABORTED);
+        return;
+    }
+
+    if ((resp == CY_PDSTACK_RES_RCVD) && (pkt_ptr != NULL) && (pkt_ptr->len != 0u))
+    {
+        cmdType = CY_PD_GET_SVDM_CMD_TYPE(pkt_ptr->dat[0].val);
+        if (cmdType == (uint32_t)CY_PDSTACK_CMD_TYPE_RESP_ACK)
+        {
+            disc_ack(ptrPdStackContext, ptrDisc, pkt_ptr);
+            return;
+        }
+        if (cmdType != (uint32_t)CY_PDSTACK_CMD_TYPE_RESP_BUSY)
+        {
+            disc_nak(ptrPdStackContext, ptrDisc);
+            return;
+        }
+    }
+
+    /* Timeout, failure or BUSY. */
+    if (ptrDisc->retry >= CY_PDSTACK_VDM_DISC_RETRY_MAX)
+    {
+        disc_nak(ptrPdStackContext, ptrDisc);
+        return;
+    }
+
+    ptrDisc->retry++;
+    if ((resp == CY_PDSTACK_RES_RCVD) && (ptrPdStackContext->ptrTimerContext != NULL) &&
+            (Cy_PdUtils_SwTimer_Start(ptrPdStackContext->ptrTimerContext, ptrPdStackContext,
+                                      DISC_TIMER_ID(ptrPdStackContext),
+                                      CY_PDSTACK_VDM_DISC_BUSY_PERIOD, disc_busy_cbk)))
+    {
+        ptrDisc->holdOff = true;
+    }
+    else
+    {
+        disc_send(ptrPdStackContext, ptrDisc);
+    }
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_VdmDiscStart(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_pdstack_vdm_disc_cbk_t doneCbk)
+{
+    disc_port_t *ptrDisc = disc_get(ptrPdStackContext);
+
+    if ((ptrDisc == NULL) || (doneCbk == NULL))
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    if (ptrDisc->table.status == CY_PDSTACK_VDM_DISC_RUNNING)
+    {
+        return CY_PDSTACK_STAT_BUSY;
+    }
+
+    ptrDisc->doneCbk = doneCbk;
+    if (ptrDisc->cached)
+    {
+        ptrDisc->table.fromCache = true;
+        doneCbk(ptrPdStackContext, &ptrDisc->table);
+        return CY_PDSTACK_STAT_SUCCESS;
+    }
+
+    if ((!ptrPdStackContext->dpmConfig.contractExist) ||
+            (ptrPdStackContext->dpmConfig.curPortType != (uint8_t)CY_PD_PRT_TYPE_DFP))
+    {
+        return CY_PDSTACK_STAT_NOT_SUPPORTED;
+    }
+
+    (void)memset(&ptrDisc->table, 0, sizeof(cy_stc_pdstack_vdm_disc_table_t));
+    (void)memset(&ptrDisc->cmdBuf, 0, sizeof(cy_stc_pdstack_dpm_pd_cmd_buf_t));
+    ptrDisc->table.status     = CY_PDSTACK_VDM_DISC_RUNNING;
+    ptrDisc->table.vdmVersion = (ptrPdStackContext->dpmConfig.specRevSopLive >= CY_PD_REV3) ?
+        (uint8_t)CY_PDSTACK_STD_VDM_VER2 : (uint8_t)CY_PDSTACK_STD_VDM_VER1;
+    ptrDisc->step    = DISC_STEP_ID;
+    ptrDisc->svidIdx = 0u;
+    ptrDisc->svidReq = 0u;
+    ptrDisc->retry   = 0u;
+    ptrDisc->holdOff = false;
+
+    disc_request(ptrPdStackContext, ptrDisc);
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_VdmDiscTask(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    disc_port_t *ptrDisc = disc_get(ptrPdStackContext);
+
+    if (ptrDisc == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    if ((ptrDisc->table.status == CY_PDSTACK_VDM_DISC_RUNNING) && (ptrDisc->pending) && (!ptrDisc->holdOff))
+    {
+        disc_send(ptrPdStackContext, ptrDisc);
+    }
+
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+void Cy_PdStack_Dpm_VdmDiscEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data)
+{
+    disc_port_t *ptrDisc = disc_get(ptrPdStackContext);
+
+    CY_UNUSED_PARAMETER(data);
+
+    if (ptrDisc == NULL)
+    {
+        return;
+    }
+
+    switch (evt)
+    {
+        case APP_EVT_DISCONNECT:
+        case APP_EVT_HARD_RESET_RCVD:
+        case APP_EVT_HARD_RESET_SENT:
+        case APP_EVT_TYPE_C_ERROR_RECOVERY:
+        case APP_EVT_VBUS_PORT_DISABLE:
+            if (ptrDisc->table.status == CY_PDSTACK_VDM_DISC_RUNNING)
+            {
+                disc_finish(ptrPdStackContext, ptrDisc, CY_PDSTACK_VDM_DISC_ABORTED);
+            }
+            ptrDisc->cached = false;
+            break;
+
+        default:
+            /* A soft reset keeps the partner identity and thus the table. */
+            break;
+    }
+}
+
+const cy_stc_pdstack_vdm_disc_table_t *Cy_PdStack_Dpm_VdmDiscGetTable(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    disc_port_t *ptrDisc = disc_get(ptrPdStackContext);
+
+    return (ptrDisc != NULL) ? &ptrDisc->table : NULL;
+}
+
+cy_en_pdstack_status_t Cy_PdStack_Dpm_VdmDiscInvalidate(
+        cy_stc_pdstack_context_t *ptrPdStackContext)
+{
+    disc_port_t *ptrDisc = disc_get(ptrPdStackContext);
+
+    if (ptrDisc == NULL)
+    {
+        return CY_PDSTACK_STAT_BAD_PARAM;
+    }
+
+    ptrDisc->cached = false;
+    return CY_PDSTACK_STAT_SUCCESS;
+}
+
+#endif /* ((CY_PD_VDM_DISC_ENABLE) && (!(CY_PD_VDM_DISABLE))) */
+
+/* [] END OF FILE */
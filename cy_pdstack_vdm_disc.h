@@ -0,0 +1,237 @@
+/***************************************************************************//**
+* \file cy_pdstack_vdm_disc.h
+* \version 4.0
+*
+* Header file of the pipelined SOP discovery engine of the PDStack middleware.
+* Discover Identity, Discover SVIDs and Discover Modes are chained from the
+* response callback of each request, and the results are reported once as a
+* complete discovery table which is kept across soft resets.
+*
+********************************************************************************
+* \copyright
+* Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDSTACK_VDM_DISC_H)
+#define CY_PDSTACK_VDM_DISC_H
+
+#include "cy_pdstack_common.h"
+
+/**
+* \addtogroup group_pdstack_macros
+* \{
+*/
+
+#ifndef CY_PDSTACK_VDM_DISC_TIMER_BASE_ID
+/** Soft timer ID used for the BUSY back-off on port 0. Port N uses this ID
+ * plus N. Can be overridden to move the timers within the application timer
+ * range. */
+#define CY_PDSTACK_VDM_DISC_TIMER_BASE_ID       (CY_PDUTILS_TIMER_APP_PORT0_START_ID + 0xE8u)
+#if (CY_PD_MAX_NO_OF_PORTS > 8u)
+#error "The default discovery timer IDs overlap the PPS stream timer IDs beyond 8 ports; override CY_PDSTACK_VDM_DISC_TIMER_BASE_ID."
+#endif
+#endif /* CY_PDSTACK_VDM_DISC_TIMER_BASE_ID */
+
+/** Number of mode VDOs kept per SVID, the most a Discover Modes response carries. */
+#define CY_PDSTACK_VDM_DISC_MAX_MODES           (CY_PD_MAX_NO_OF_VDO - 1u)
+
+/** Number of times a request is repeated after a timeout or a BUSY response. */
+#define CY_PDSTACK_VDM_DISC_RETRY_MAX           (2u)
+
+/** Delay in ms before a request is repeated after a BUSY response (tVDMBusy). */
+#define CY_PDSTACK_VDM_DISC_BUSY_PERIOD         (50u)
+
+/** \} group_pdstack_macros */
+
+/**
+* \addtogroup group_pdstack_enums
+* \{
+*/
+
+/**
+ * @typedef cy_en_pdstack_vdm_disc_status_t
+ * @brief Status of the discovery of a port.
+ */
+typedef enum
+{
+    CY_PDSTACK_VDM_DISC_IDLE = 0,       /**< No discovery result. */
+    CY_PDSTACK_VDM_DISC_RUNNING,        /**< Discovery in progress. */
+    CY_PDSTACK_VDM_DISC_COMPLETE,       /**< Discovery completed, the table is valid. */
+    CY_PDSTACK_VDM_DISC_NOT_SUPPORTED,  /**< Port partner NAKed or did not answer Discover Identity. */
+    CY_PDSTACK_VDM_DISC_ABORTED         /**< Discovery aborted by a reset or detach. */
+} cy_en_pdstack_vdm_disc_status_t;
+
+/** \} group_pdstack_enums */
+
+/**
+* \addtogroup group_pdstack_data_structures
+* \{
+*/
+
+/**
+ * @brief Discover Modes result of one SVID.
+ */
+typedef struct
+{
+    uint16_t    svid;                                   /**< SVID. */
+    uint8_t     numModes;                               /**< Number of valid entries in modeVdo. */
+    bool        ack;                                    /**< Discover Modes was ACKed. */
+    uint32_t    modeVdo[CY_PDSTACK_VDM_DISC_MAX_MODES]; /**< Mode VDOs, in object position order. */
+} cy_stc_pdstack_vdm_disc_svid_t;
+
+/**
+ * @brief Discovery table of the SOP port partner.
+ */
+typedef struct
+{
+    cy_en_pdstack_vdm_disc_status_t status;             /**< Discovery status. */
+    bool                            fromCache;          /**< Reported from the result of an
+                                                             earlier discovery on this connection. */
+    bool                            svidOverflow;       /**< The partner reported more than
+                                                             CY_PD_VDM_DISC_MAX_SVIDS SVIDs. */
+    uint8_t                         vdmVersion;         /**< Structured VDM version in use,
+                                                             cy_en_pdstack_std_vdm_ver_t. */
+    uint8_t                         idCount;            /**< Number of valid entries in idVdo. */
+    uint8_t                         numSvids;           /**< Number of valid entries in svid. */
+    uint32_t                        idVdo[CY_PD_MAX_NO_OF_VDO - 1u];    /**< Discover Identity VDOs, starting
+                                                                             with the ID header. */
+    cy_stc_pdstack_vdm_disc_svid_t  svid[CY_PD_VDM_DISC_MAX_SVIDS];     /**< SVIDs in the reported order. */
+} cy_stc_pdstack_vdm_disc_table_t;
+
+/**
+ * @brief Callback which receives the discovery table once the discovery has
+ * ended, with the status telling whether it completed.
+ */
+typedef void (*cy_pdstack_vdm_disc_cbk_t)(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        const cy_stc_pdstack_vdm_disc_table_t *ptrTable);
+
+/** \} group_pdstack_data_structures */
+
+/**
+* \addtogroup group_pdstack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_VdmDiscStart
+****************************************************************************//**
+*
+* Starts the discovery of the SOP port partner. Each response is parsed in the
+* command callback, which sends the next request at once; a request the stack
+* cannot take yet is sent from Cy_PdStack_Dpm_VdmDiscTask. Discover Modes is
+* sent for every SVID reported, and the SVIDs are skipped when the partner does
+* not support modal operation.
+*
+* If a complete table from an earlier discovery on the same connection is held,
+* for example after a soft reset, no message is sent and doneCbk is called
+* from this function with fromCache set.
+*
+* The alternate mode manager uses this engine in place of its own discovery
+* phase and goes on with Enter Mode from doneCbk.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param doneCbk
+* Callback which receives the table. Must not be NULL.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the discovery is started or reported from the cache.
+* CY_PDSTACK_STAT_BUSY if a discovery is already running.
+* CY_PDSTACK_STAT_NOT_SUPPORTED if the port is not a DFP with an explicit contract.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_VdmDiscStart(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_pdstack_vdm_disc_cbk_t doneCbk);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_VdmDiscTask
+****************************************************************************//**
+*
+* Sends a discovery request which the stack could not take from the command
+* callback. Called from the event-driven scheduler after the stack task, or
+* from the main loop otherwise.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_VdmDiscTask(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_VdmDiscEventHandler
+****************************************************************************//**
+*
+* Maintains the cached table from the application events of the port. To be
+* called from the application event handler. The table is dropped on detach,
+* hard reset, Type-C error recovery and port disable, and kept on soft reset.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \param evt
+* Event ID.
+*
+* \param data
+* Event data.
+*
+* \return
+* None
+*
+*******************************************************************************/
+void Cy_PdStack_Dpm_VdmDiscEventHandler(
+        cy_stc_pdstack_context_t *ptrPdStackContext,
+        cy_en_pdstack_app_evt_t evt,
+        const void *data);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_VdmDiscGetTable
+****************************************************************************//**
+*
+* Returns the discovery table of a port.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* Pointer to the table, or NULL if the input parameters are not valid.
+*
+*******************************************************************************/
+const cy_stc_pdstack_vdm_disc_table_t *Cy_PdStack_Dpm_VdmDiscGetTable(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/*******************************************************************************
+* Function name: Cy_PdStack_Dpm_VdmDiscInvalidate
+****************************************************************************//**
+*
+* Drops the cached table of a port, so that the next
+* Cy_PdStack_Dpm_VdmDiscStart runs a new discovery. A running discovery is
+* not affected.
+*
+* \param ptrPdStackContext
+* PDStack library context pointer.
+*
+* \return
+* CY_PDSTACK_STAT_SUCCESS if the operation is successful.
+* CY_PDSTACK_STAT_BAD_PARAM if the input parameters are not valid.
+*
+*******************************************************************************/
+cy_en_pdstack_status_t Cy_PdStack_Dpm_VdmDiscInvalidate(
+        cy_stc_pdstack_context_t *ptrPdStackContext);
+
+/** \} group_pdstack_functions */
+
+#endif /* CY_PDSTACK_VDM_DISC_H */
+
+/* [] END OF FILE */
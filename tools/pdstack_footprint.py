@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+#
+# Host-side flash and RAM footprint report of the PDStack middleware, read from
+# a GNU ld map file (-Wl,-Map=<file>).
+#
+# Every input section linked from the PDStack library archive or from one of
+# the PDStack source modules is attributed to its object: the archive members
+# are reported as "<library>(<member>)" and the source modules by their name
+# without the cy_pdstack_ prefix. Sections removed by --gc-sections do not
+# appear in the memory map and are therefore not counted, so the report shows
+# what the product actually links.
+#
+# With --max-flash or --max-ram, the exit status is 1 if the PDStack total
+# exceeds the limit.
+#
+# Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+# You may use this file only in accordance with the license, terms, conditions,
+# disclaimers, and limitations in the end user license agreement accompanying
+# the software package with which this file was provided.
+
+import argparse
+import os
+import re
+import sys
+
+SECTION_ONE_LINE = re.compile(r"^ (\.\S+|COMMON)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+SECTION_NAME = re.compile(r"^ (\.\S+|COMMON)$")
+SECTION_REST = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+ARCHIVE_MEMBER = re.compile(r"^(.*?)([^/\\]+\.a)\((.+)\)$")
+
+FLASH_PREFIXES = (".text", ".rodata", ".ARM.extab", ".ARM.exidx")
+DATA_PREFIXES = (".data",)
+RAM_PREFIXES = (".bss", ".noinit", "COMMON")
+
+
+def classify(section):
+    """Returns (flash, ram) weights of an input section."""
+    if section.startswith(FLASH_PREFIXES):
+        return (1, 0)
+    if section.startswith(DATA_PREFIXES):
+        return (1, 1)
+    if section.startswith(RAM_PREFIXES):
+        return (0, 1)
+    return (0, 0)
+
+
+def group_of(path):
+    """Returns the report group of an input file, or None if it is not part
+    of the PDStack middleware."""
+    path = path.strip()
+    m = ARCHIVE_MEMBER.match(path)
+    if m:
+        lib, member = m.group(2), m.group(3)
+        if lib.startswith("libpmg1_"):
+            return "%s(%s)" % (lib, member)
+        return None
+
+    name = os.path.basename(path)
+    if name.startswith("cy_pdstack_") and name.endswith(".o"):
+        return name[len("cy_pdstack_"):-len(".o")]
+    return None
+
+
+def parse_map(lines):
+    groups = {}
+    in_map = False
+    pending = None
+
+    for line in lines:
+        line = line.rstrip("\n")
+        if not in_map:
+            # Discarded input sections are listed before the memory map.
+            in_map = line.startswith("Linker script and memory map")
+            continue
+
+        m = SECTION_ONE_LINE.match(line)
+        if m:
+            section, size, path = m.group(1), int(m.group(3), 16), m.group(4)
+        elif pending is not None:
+            m = SECTION_REST.match(line)
+            section, pending = pending, None
+            if not m:
+                continue
+            size, path = int(m.group(2), 16), m.group(3)
+        else:
+            m = SECTION_NAME.match(line)
+            if m:
+                pending = m.group(1)
+            continue
+
+        grp = group_of(path)
+        flash, ram = classify(section)
+        if (grp is None) or (size == 0) or ((flash | ram) == 0):
+            continue
+
+        entry = groups.setdefault(grp, {"flash": 0, "ram": 0})
+        entry["flash"] += flash * size
+        entry["ram"] += ram * size
+
+    return groups
+
+
+def report(groups, out):
+    total = {"flash": 0, "ram": 0}
+    out.write("%-48s %10s %10s\n" % ("object", "flash", "ram"))
+    for grp in sorted(groups, key=lambda g: (-groups[g]["flash"], g)):
+        out.write("%-48s %10d %10d\n" % (grp, groups[grp]["flash"], groups[grp]["ram"]))
+        total["flash"] += groups[grp]["flash"]
+        total["ram"] += groups[grp]["ram"]
+    out.write("%-48s %10d %10d\n" % ("total", total["flash"], total["ram"]))
+    return total
+
+
+def main():
+    parser = argparse.ArgumentParser(description="PDStack footprint report from a GNU ld map file")
+    parser.add_argument("map", help="linker map file")
+    parser.add_argument("--max-flash", type=int, help="flash limit in bytes of the PDStack total")
+    parser.add_argument("--max-ram", type=int, help="RAM limit in bytes of the PDStack total")
+    args = parser.parse_args()
+
+    with open(args.map, "r", errors="replace") as f:
+        groups = parse_map(f)
+
+    if not groups:
+        sys.stderr.write("no PDStack objects found in %s\n" % args.map)
+        return 1
+
+    total = report(groups, sys.stdout)
+
+    fail = False
+    if (args.max_flash is not None) and (total["flash"] > args.max_flash):
+        sys.stdout.write("FAIL: flash %d > %d\n" % (total["flash"], args.max_flash))
+        fail = True
+    if (args.max_ram is not None) and (total["ram"] > args.max_ram):
+        sys.stdout.write("FAIL: ram %d > %d\n" % (total["ram"], args.max_ram))
+        fail = True
+
+    return 1 if fail else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
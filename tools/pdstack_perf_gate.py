@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+#
+# Host-side report and regression gate of the PDStack latency statistics
+# (cy_pdstack_perf.h).
+#
+# Input is a raw little-endian dump of one cy_stc_pdstack_perf_stats_t, for
+# example read over HPI or saved from a debugger after a test run, and
+# optionally one cy_stc_pdstack_mem_footprint_t (cy_pdstack_mem.h). Statistic
+# names are taken from cy_pdstack_perf.h so that the output follows the header
+# in use.
+#
+# With --baseline, every limit of the baseline file is checked and the exit
+# status is 1 if any is exceeded. --save writes a baseline from the dump, with
+# the limits set --margin percent above the measured values.
+#
+# Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+# You may use this file only in accordance with the license, terms, conditions,
+# disclaimers, and limitations in the end user license agreement accompanying
+# the software package with which this file was provided.
+
+import argparse
+import json
+import os
+import struct
+import sys
+
+from pdstack_trace_decode import parse_enum
+
+STAT_FORMAT = "<IIII8H"
+STAT_FIELDS = ("count", "minUs", "maxUs", "lastUs")
+
+FOOTPRINT_FORMAT = "<7H"
+FOOTPRINT_FIELDS = ("contextSize", "dpmStatSize", "dpmExtStatSize", "pdStatSize",
+                    "peStatSize", "typecStatSize", "amsScratchSize")
+
+
+def load_stats(data, names):
+    size = struct.calcsize(STAT_FORMAT)
+    if (len(data) == 0) or (len(data) % size) != 0:
+        raise ValueError("dump size %d is not a multiple of %d" % (len(data), size))
+
+    stats = {}
+    for idx in range(len(data) // size):
+        val = struct.unpack_from(STAT_FORMAT, data, idx * size)
+        key = names.get(idx, "STAT_%02X" % idx)
+        stats[key] = dict(zip(STAT_FIELDS, val[:4]))
+        stats[key]["hist"] = list(val[4:])
+    return stats
+
+
+def load_footprint(data):
+    if len(data) < struct.calcsize(FOOTPRINT_FORMAT):
+        raise ValueError("footprint dump too short")
+    return dict(zip(FOOTPRINT_FIELDS, struct.unpack_from(FOOTPRINT_FORMAT, data, 0)))
+
+
+def report(stats, footprint, out):
+    out.write("%-34s %8s %10s %10s %10s\n" % ("statistic", "count", "min us", "max us", "last us"))
+    for key, st in stats.items():
+        if st["count"] == 0:
+            continue
+        out.write("%-34s %8u %10u %10u %10u\n" % (key, st["count"], st["minUs"], st["maxUs"], st["lastUs"]))
+    if footprint:
+        out.write("\n")
+        for key in FOOTPRINT_FIELDS:
+            out.write("%-34s %8u bytes\n" % (key, footprint[key]))
+
+
+def check(stats, footprint, baseline, out):
+    """Returns the number of limits exceeded."""
+    failed = 0
+    for key, limits in baseline.get("stats", {}).items():
+        st = stats.get(key)
+        if (st is None) or (st["count"] == 0):
+            out.write("MISSING  %s: no samples\n" % key)
+            failed += 1
+            continue
+        for field, limit in limits.items():
+            if st[field] > limit:
+                out.write("FAIL     %s.%s = %u > %u\n" % (key, field, st[field], limit))
+                failed += 1
+    for key, limit in baseline.get("footprint", {}).items():
+        if footprint and (footprint[key] > limit):
+            out.write("FAIL     %s = %u > %u\n" % (key, footprint[key], limit))
+            failed += 1
+    return failed
+
+
+def make_baseline(stats, footprint, margin):
+    def lim(val):
+        return int(val + (val * margin + 99) // 100)
+
+    baseline = {"stats": {}}
+    for key, st in stats.items():
+        if st["count"] != 0:
+            baseline["stats"][key] = {"maxUs": lim(st["maxUs"])}
+    if footprint:
+        baseline["footprint"] = {"contextSize": footprint["contextSize"]}
+    return baseline
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description="Report and gate PDStack latency statistics.")
+    parser.add_argument("dump", help="raw dump of cy_stc_pdstack_perf_stats_t")
+    parser.add_argument("--footprint", help="raw dump of cy_stc_pdstack_mem_footprint_t")
+    parser.add_argument("--header", default=os.path.join(here, "..", "cy_pdstack_perf.h"),
+                        help="PDStack header providing the statistic names")
+    parser.add_argument("--baseline", help="baseline JSON file to check against")
+    parser.add_argument("--save", help="write a baseline JSON file from the dump")
+    parser.add_argument("--margin", type=int, default=10,
+                        help="percentage added to the measured values by --save")
+    args = parser.parse_args()
+
+    with open(args.header, "r", encoding="utf-8", errors="replace") as f:
+        names = parse_enum(f.read(), "cy_en_pdstack_perf_id_t")
+    with open(args.dump, "rb") as f:
+        stats = load_stats(f.read(), names)
+    footprint = None
+    if args.footprint:
+        with open(args.footprint, "rb") as f:
+            footprint = load_footprint(f.read())
+
+    report(stats, footprint, sys.stdout)
+
+    if args.save:
+        with open(args.save, "w", encoding="utf-8") as f:
+            json.dump(make_baseline(stats, footprint, args.margin), f, indent=4)
+            f.write("\n")
+
+    if args.baseline:
+        with open(args.baseline, "r", encoding="utf-8") as f:
+            failed = check(stats, footprint, json.load(f), sys.stdout)
+        if failed != 0:
+            sys.stdout.write("%d limit(s) exceeded\n" % failed)
+            return 1
+        sys.stdout.write("all limits met\n")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+#
+# Host-side decoder of the PDStack binary event trace (cy_pdstack_trace.h).
+#
+# Input is a raw little-endian dump of one cy_stc_pdstack_trace_t, for example
+# read over HPI or saved from a debugger. Enumerator names are taken from
+# cy_pdstack_common_default.h so that the output follows the header in use.
+#
+# Copyright 2021-2024, Cypress Semiconductor Corporation. All rights reserved.
+# You may use this file only in accordance with the license, terms, conditions,
+# disclaimers, and limitations in the end user license agreement accompanying
+# the software package with which this file was provided.
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+TRACE_TYPES = {
+    0x00: "NONE",
+    0x01: "TYPEC_STATE",
+    0x02: "PE_STATE",
+    0x03: "APP_EVT",
+    0x04: "MSG_RX",
+    0x05: "DPM_CMD",
+    0x06: "TIMER",
+}
+
+SOP_NAMES = ["SOP", "SOP'", "SOP''", "SOP'_DBG", "SOP''_DBG", "HARD_RESET", "CABLE_RESET", "7"]
+
+HDR_FORMAT = "<BBH"
+REC_FORMAT = "<IBBH"
+
+
+def parse_enum(text, name):
+    """Returns {value: enumerator} of the typedef enum called name."""
+    end = re.search(r"\}\s*" + re.escape(name) + r"\s*;", text)
+    if end is None:
+        return {}
+    start = text.rfind("typedef enum", 0, end.start())
+    if start < 0:
+        return {}
+
+    body = text[text.index("{", start) + 1:end.start()]
+    body = re.sub(r"/\*.*?\*/", "", body, flags=re.S)
+    values = {}
+    nxt = 0
+    for line in body.splitlines():
+        line = line.strip()
+        if (not line) or line.startswith("#"):
+            continue
+        for item in line.split(","):
+            item = item.strip()
+            if not item:
+                continue
+            if "=" in item:
+                key, val = [x.strip() for x in item.split("=", 1)]
+                try:
+                    nxt = int(val.rstrip("uU"), 0)
+                except ValueError:
+                    continue
+            else:
+                key = item
+            values.setdefault(nxt, key)
+            nxt += 1
+    return values
+
+
+def load_names(header):
+    with open(header, "r", encoding="utf-8", errors="replace") as f:
+        text = f.read()
+    return {
+        "typec": parse_enum(text, "cy_en_pdstack_typec_fsm_state_t"),
+        "pe": parse_enum(text, "cy_en_pdstack_pe_fsm_state_t"),
+        "evt": parse_enum(text, "cy_en_pdstack_app_evt_t"),
+        "hr": parse_enum(text, "cy_en_pdstack_hard_reset_reason_t"),
+        "contract": parse_enum(text, "cy_en_pdstack_contract_status_t"),
+        "cmd": parse_enum(text, "cy_en_pdstack_dpm_pd_cmd_t"),
+        "resp": parse_enum(text, "cy_en_pdstack_resp_status_t"),
+    }
+
+
+def name(table, val):
+    return table.get(val, "0x%02X" % val)
+
+
+def describe(names, rtype, arg0, arg1):
+    if rtype == 0x01:
+        return "%s <- %s" % (name(names["typec"], arg0), name(names["typec"], arg1))
+    if rtype == 0x02:
+        return "%s <- %s" % (name(names["pe"], arg0), name(names["pe"], arg1))
+    if rtype == 0x03:
+        evt = name(names["evt"], arg0)
+        if evt.startswith("APP_EVT_HARD_RESET") and arg1 != 0:
+            return "%s reason=%s" % (evt, name(names["hr"], arg1))
+        if evt == "APP_EVT_PD_CONTRACT_NEGOTIATION_COMPLETE":
+            return "%s status=%s" % (evt, name(names["contract"], arg1))
+        return evt
+    if rtype == 0x04:
+        sop = (arg1 >> 10) & 0x7
+        extd = (arg1 >> 9) & 0x1
+        cnt = (arg1 >> 5) & 0xF
+        msg = arg1 & 0x1F
+        if extd:
+            kind = "EXTD"
+        elif cnt == 0:
+            kind = "CTRL"
+        else:
+            kind = "DATA"
+        return "%s %s msg=0x%02X do=%d" % (SOP_NAMES[sop], kind, msg, cnt)
+    if rtype == 0x05:
+        return "%s %s" % (name(names["cmd"], arg0), name(names["resp"], arg1))
+    if rtype == 0x06:
+        return "timer 0x%04X" % arg1
+    return "arg0=0x%02X arg1=0x%04X" % (arg0, arg1)
+
+
+def decode(data, names, out):
+    hdr_size = struct.calcsize(HDR_FORMAT)
+    rec_size = struct.calcsize(REC_FORMAT)
+    if len(data) < hdr_size:
+        raise ValueError("dump too short")
+
+    port, depth_log2, wr_idx = struct.unpack_from(HDR_FORMAT, data, 0)
+    depth = 1 << depth_log2
+    if len(data) < hdr_size + depth * rec_size:
+        raise ValueError("dump too short for %d records" % depth)
+
+    recs = [struct.unpack_from(REC_FORMAT, data, hdr_size + i * rec_size) for i in range(depth)]
+    mask = depth - 1
+    head = wr_idx & mask
+    count = depth if recs[head][1] != 0 else head
+
+    out.write("port %d, %d of %d records\n" % (port, count, depth))
+    prev = None
+    for i in range(count):
+        time, rtype, arg0, arg1 = recs[(wr_idx - count + i) & mask]
+        delta = "" if prev is None else "+%d" % ((time - prev) & 0xFFFFFFFF)
+        prev = time
+        tname = TRACE_TYPES.get(rtype, "USER_%02X" % rtype if rtype >= 0x80 else "0x%02X" % rtype)
+        out.write("%10u %10s  %-12s %s\n" % (time, delta, tname, describe(names, rtype, arg0, arg1)))
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description="Decode a PDStack binary trace dump.")
+    parser.add_argument("dump", help="raw dump of cy_stc_pdstack_trace_t")
+    parser.add_argument("--header", default=os.path.join(here, "..", "cy_pdstack_common_default.h"),
+                        help="PDStack header providing the enumerator names")
+    args = parser.parse_args()
+
+    with open(args.dump, "rb") as f:
+        data = f.read()
+    decode(data, load_names(args.header), sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())